@@ -0,0 +1,128 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Weighted 8-connected grid map used as a benchmark workload
+
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+namespace cds
+{
+
+struct grid_cell
+{
+	int x{0};
+	int y{0};
+
+	bool operator==(grid_cell const& c) const { return x == c.x && y == c.y; }
+	bool operator!=(grid_cell const& c) const { return !(*this == c); }
+};
+
+class grid_map
+{
+	int m_width;
+	int m_height;
+
+	std::vector<uint8_t> m_cell_cost;	// 0 == obstacle
+
+public:
+	/// Random map, obstacle_ratio of the cells are blocked, the
+	/// rest have a traversal cost between 1 and max_cell_cost.
+	grid_map(int width, int height, double obstacle_ratio, int max_cell_cost, unsigned int seed)
+		: m_width(width)
+		, m_height(height)
+		, m_cell_cost(width * height)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> obstacle_dist(0.0, 1.0);
+		std::uniform_int_distribution<int> cost_dist(1, max_cell_cost);
+
+		for (uint8_t& c : m_cell_cost)
+			c = obstacle_dist(gen) < obstacle_ratio ? 0 : static_cast<uint8_t>(cost_dist(gen));
+
+		// Keep the corners open
+		m_cell_cost.front() = 1;
+		m_cell_cost.back() = 1;
+	}
+
+	int width() const { return m_width; }
+	int height() const { return m_height; }
+
+	grid_cell min_corner() const { return grid_cell{0, 0}; }
+	grid_cell max_corner() const { return grid_cell{m_width - 1, m_height - 1}; }
+
+	bool is_open(grid_cell const& c) const
+	{
+		return c.x >= 0 && c.y >= 0 && c.x < m_width && c.y < m_height &&
+			m_cell_cost[c.y * m_width + c.x] != 0;
+	}
+
+	int cell_cost(grid_cell const& c) const { return m_cell_cost[c.y * m_width + c.x]; }
+
+	std::vector<grid_cell> expand(grid_cell const& c) const
+	{
+		std::vector<grid_cell> neighbors;
+		neighbors.reserve(8);
+
+		for (int dy = -1 ; dy <= 1 ; dy++)
+		{
+			for (int dx = -1 ; dx <= 1 ; dx++)
+			{
+				if (dx == 0 && dy == 0)
+					continue;
+
+				grid_cell const n{ c.x + dx, c.y + dy };
+				if (is_open(n))
+					neighbors.push_back(n);
+			}
+		}
+
+		return neighbors;
+	}
+
+	/// Cost of moving between adjacent cells, the step length times the cost of the cell we enter
+	double weight(grid_cell const& c1, grid_cell const& c2) const
+	{
+		double const step = (c1.x != c2.x && c1.y != c2.y) ? std::sqrt(2.0) : 1.0;
+		return step * cell_cost(c2);
+	}
+
+	/// Octile distance, admissible since every cell costs at least 1
+	static double octile_dist(grid_cell const& c1, grid_cell const& c2)
+	{
+		double const dx = std::abs(c1.x - c2.x);
+		double const dy = std::abs(c1.y - c2.y);
+
+		return (dx + dy) + (std::sqrt(2.0) - 2.0) * std::min(dx, dy);
+	}
+};
+
+} // namespace cds
+
+namespace std
+{
+	template <>
+	class hash<cds::grid_cell>
+	{
+	public:
+		size_t operator()(cds::grid_cell const& c) const
+		{
+			return (static_cast<size_t>(c.x) * 73856093u) ^ (static_cast<size_t>(c.y) * 83492791u);
+		}
+	};
+}
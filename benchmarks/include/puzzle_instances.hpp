@@ -0,0 +1,49 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// n^2 - 1 puzzle instances used as benchmark workloads
+
+#pragma once
+
+#include <n_sq_puzzle.hpp>
+
+#include <vector>
+#include <random>
+
+namespace cds
+{
+
+/// Instances made by random walks from the goal, seeded by their index
+/// (random shuffles of the 15-puzzle are too hard for the Manhattan distance heuristic)
+template <size_t N>
+std::vector<n_sq_puzzle<N>> random_walk_puzzles(size_t num_puzzles, size_t num_moves)
+{
+	using MoveType = typename n_sq_puzzle<N>::MoveType;
+
+	std::vector<n_sq_puzzle<N>> puzzles;
+	for (size_t i = 0 ; i < num_puzzles ; i++)
+	{
+		std::mt19937 gen(static_cast<unsigned int>(i + 1));
+		std::uniform_int_distribution<int> random_move(0, 3);
+
+		n_sq_puzzle<N> puz;
+		for (size_t m = 0 ; m < num_moves ; )
+			if (puz.move(static_cast<MoveType>(random_move(gen))))
+				m++;
+
+		puzzles.push_back(puz);
+	}
+
+	return puzzles;
+}
+
+} // namespace cds
@@ -0,0 +1,123 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Batches of puzzle queries, a_star_search() in a loop vs. batch_searcher
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/batch_search.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <puzzle_instances.hpp>
+
+#include <vector>
+#include <utility>
+#include <iterator>
+
+using namespace cds;
+
+namespace
+{
+	template <size_t N>
+	using puzzle_query_t = std::pair<n_sq_puzzle<N>, n_sq_puzzle<N>>;
+
+	template <size_t N>
+	std::vector<puzzle_query_t<N>> const& puzzle_batch();
+
+	/// Random shuffles of the 8-puzzle
+	template <>
+	std::vector<puzzle_query_t<3>> const& puzzle_batch<3>()
+	{
+		static std::vector<puzzle_query_t<3>> const queries = []
+		{
+			std::vector<puzzle_query_t<3>> q(64);
+			for (size_t i = 0 ; i < q.size() ; i++)
+				q[i].first.shuffle(static_cast<unsigned int>(i + 1));
+
+			return q;
+		}();
+
+		return queries;
+	}
+
+	/// Random walks for the 15-puzzle, its random shuffles are too hard for A* with the Manhattan distance
+	template <>
+	std::vector<puzzle_query_t<4>> const& puzzle_batch<4>()
+	{
+		static std::vector<puzzle_query_t<4>> const queries = []
+		{
+			std::vector<puzzle_query_t<4>> q;
+			for (auto const& puz : random_walk_puzzles<4>(32, 60))
+				q.emplace_back(puz, n_sq_puzzle<4>());
+
+			return q;
+		}();
+
+		return queries;
+	}
+
+	template <size_t N>
+	size_t unit_weight(n_sq_puzzle<N> const&, n_sq_puzzle<N> const&)
+	{
+		return 1;
+	}
+}
+
+template <size_t N>
+static void BM_PuzzleBatchAStarLoop(benchmark::State& state)
+{
+	auto const& queries = puzzle_batch<N>();
+
+	for (auto _ : state)
+	{
+		for (auto const& [start, goal] : queries)
+		{
+			std::vector<n_sq_puzzle<N>> path;
+			bool const found = astar::a_star_search(
+				start, &expand<N>,
+				[&goal = goal](n_sq_puzzle<N> const& p) { return tile_taxicab_dist(p, goal); },
+				&unit_weight<N>,
+				[&goal = goal](n_sq_puzzle<N> const& p) { return p == goal; },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["queries/s"] = benchmark::Counter(
+		static_cast<double>(state.iterations() * queries.size()), benchmark::Counter::kIsRate);
+}
+
+template <size_t N>
+static void BM_PuzzleBatchSearch(benchmark::State& state)
+{
+	auto const& queries = puzzle_batch<N>();
+
+	astar::batch_searcher<n_sq_puzzle<N>, size_t (*)(n_sq_puzzle<N> const&, n_sq_puzzle<N> const&)>
+		searcher(static_cast<unsigned int>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		auto const results = searcher.search(queries.begin(), queries.end(), &expand<N>, &tile_taxicab_dist<N>, &unit_weight<N>);
+		benchmark::DoNotOptimize(results.data());
+	}
+
+	state.counters["queries/s"] = benchmark::Counter(
+		static_cast<double>(state.iterations() * queries.size()), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleBatchAStarLoop, 3)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PuzzleBatchSearch, 3)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PuzzleBatchAStarLoop, 4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PuzzleBatchSearch, 4)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
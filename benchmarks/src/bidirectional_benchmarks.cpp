@@ -0,0 +1,143 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Unidirectional vs. bidirectional A* on point-to-point grid queries
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/bidirectional_a_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <grid_map.hpp>
+
+#include <vector>
+#include <iterator>
+#include <limits>
+#include <random>
+
+using namespace cds;
+
+namespace
+{
+	grid_map const& the_grid_map()
+	{
+		static grid_map const map(256, 256, 0.25, 4, 1234u);
+		return map;
+	}
+
+	/// Random pairs of open cells
+	std::vector<std::pair<grid_cell, grid_cell>> const& the_queries()
+	{
+		static std::vector<std::pair<grid_cell, grid_cell>> const queries = []
+		{
+			grid_map const& map = the_grid_map();
+			grid_cell const max_corner = map.max_corner();
+
+			std::mt19937 gen(42u);
+			std::uniform_int_distribution<int> random_x(0, max_corner.x);
+			std::uniform_int_distribution<int> random_y(0, max_corner.y);
+
+			auto random_cell = [&]
+			{
+				while (true)
+				{
+					grid_cell const c{ random_x(gen), random_y(gen) };
+					if (map.is_open(c))
+						return c;
+				}
+			};
+
+			std::vector<std::pair<grid_cell, grid_cell>> q;
+			for (int i = 0 ; i < 16 ; i++)
+			{
+				grid_cell const start = random_cell();
+				q.emplace_back(start, random_cell());
+			}
+
+			return q;
+		}();
+
+		return queries;
+	}
+
+	void report_stats(benchmark::State& state, astar::search_stats const& stats)
+	{
+		double const num_queries = static_cast<double>(the_queries().size());
+		state.counters["expanded/query"] = static_cast<double>(stats.nodes_expanded) / num_queries;
+		state.counters["peak_nodes"] = static_cast<double>(stats.peak_num_nodes);
+	}
+}
+
+static void BM_GridQueriesAStar(benchmark::State& state)
+{
+	grid_map const& map = the_grid_map();
+
+	astar::search_stats stats;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+		for (auto const& q : the_queries())
+		{
+			grid_cell const goal = q.second;
+
+			std::vector<grid_cell> path;
+			bool const found = astar::a_star_search<astar::search_policy<astar::binary_heap_fringe>>(
+				q.first,
+				[&map](grid_cell const& c) { return map.expand(c); },
+				[&goal](grid_cell const& c) { return grid_map::octile_dist(c, goal); },
+				[&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); },
+				[&goal](grid_cell const& c) { return c == goal; },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<double>::max(), astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	report_stats(state, stats);
+}
+
+static void BM_GridQueriesBidirectional(benchmark::State& state)
+{
+	grid_map const& map = the_grid_map();
+
+	astar::search_stats stats;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+		for (auto const& q : the_queries())
+		{
+			grid_cell const start = q.first;
+			grid_cell const goal = q.second;
+
+			// The grid's neighbors are symmetric, so expand() also gives the predecessors
+			std::vector<grid_cell> path;
+			bool const found = astar::bidirectional_a_star_search<astar::search_policy<astar::binary_heap_fringe>>(
+				start, goal,
+				[&map](grid_cell const& c) { return map.expand(c); },
+				[&map](grid_cell const& c) { return map.expand(c); },
+				[&goal](grid_cell const& c) { return grid_map::octile_dist(c, goal); },
+				[&start](grid_cell const& c) { return grid_map::octile_dist(c, start); },
+				[&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<double>::max(), astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	report_stats(state, stats);
+}
+
+BENCHMARK(BM_GridQueriesAStar)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GridQueriesBidirectional)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,47 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Breadth first search over every 8-puzzle state, with a
+// 2-bit visited array, using different numbers of threads
+
+#include <benchmark/benchmark.h>
+
+#include <astar/breadth_first_search.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <vector>
+
+using namespace cds;
+
+static void BM_Puzzle3DistanceTable(benchmark::State& state)
+{
+	unsigned int const num_threads = static_cast<unsigned int>(state.range(0));
+	size_t const num_states = n_sq_puzzle<3>::num_states();
+
+	for (auto _ : state)
+	{
+		std::vector<uint8_t> const distances = astar::breadth_first_distance_table(
+			n_sq_puzzle<3>(), num_states, &expand<3>,
+			[](n_sq_puzzle<3> const& p) { return p.rank(); },
+			&n_sq_puzzle<3>::unrank,
+			num_threads);
+
+		benchmark::DoNotOptimize(distances.data());
+	}
+
+	state.counters["states/s"] = benchmark::Counter(
+		static_cast<double>(num_states * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Puzzle3DistanceTable)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,138 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Compares the A* fringe implementations (peak fringe size, pops, runtime)
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <grid_map.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+using namespace cds;
+
+namespace
+{
+	/// Wraps a fringe policy and records the peak fringe size and the number of pops
+	template <typename Fringe>
+	struct counting_fringe
+	{
+		static inline size_t peak_size = 0;
+		static inline size_t num_pops = 0;
+
+		static void reset() { peak_size = 0; num_pops = 0; }
+
+		template <typename NodeType, typename CostFn>
+		class type : public Fringe::template type<NodeType, CostFn>
+		{
+			using base_t = typename Fringe::template type<NodeType, CostFn>;
+
+		public:
+			void push(typename base_t::value_type const& v)
+			{
+				base_t::push(v);
+				peak_size = std::max(peak_size, base_t::size());
+			}
+
+			typename base_t::value_type pop()
+			{
+				num_pops++;
+				return base_t::pop();
+			}
+		};
+	};
+
+	template <typename Fringe>
+	void report_fringe_counters(benchmark::State& state)
+	{
+		state.counters["peak_fringe"] = static_cast<double>(counting_fringe<Fringe>::peak_size);
+		state.counters["pops"] = static_cast<double>(counting_fringe<Fringe>::num_pops);
+	}
+
+	grid_map const& the_grid_map()
+	{
+		static grid_map const map(256, 256, 0.25, 4, 1234u);
+		return map;
+	}
+}
+
+template <typename Fringe>
+static void BM_GridSearch(benchmark::State& state)
+{
+	grid_map const& map = the_grid_map();
+	grid_cell const goal = map.max_corner();
+
+	for (auto _ : state)
+	{
+		counting_fringe<Fringe>::reset();
+
+		std::vector<grid_cell> path;
+		bool const found = astar::a_star_search<astar::search_policy<counting_fringe<Fringe>>>(
+			map.min_corner(),
+			[&map](grid_cell const& c) { return map.expand(c); },
+			[&goal](grid_cell const& c) { return grid_map::octile_dist(c, goal); },
+			[&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); },
+			[&goal](grid_cell const& c) { return c == goal; },
+			std::back_inserter(path));
+
+		benchmark::DoNotOptimize(found);
+	}
+
+	report_fringe_counters<Fringe>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_GridSearch, astar::lazy_fringe)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GridSearch, astar::binary_heap_fringe)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GridSearch, astar::d_ary_heap_fringe<4>)->Unit(benchmark::kMillisecond);
+
+template <typename Fringe>
+static void BM_PuzzleSearch(benchmark::State& state)
+{
+	n_sq_puzzle<3> const goal;
+
+	std::vector<n_sq_puzzle<3>> puzzles(16);
+	for (size_t i = 0 ; i < puzzles.size() ; i++)
+		puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+	for (auto _ : state)
+	{
+		counting_fringe<Fringe>::reset();
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<3>> path;
+			bool const found = astar::a_star_search<astar::search_policy<counting_fringe<Fringe>>>(
+				puz,
+				&expand<3>,
+				[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+				[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+				[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	report_fringe_counters<Fringe>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleSearch, astar::lazy_fringe)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearch, astar::binary_heap_fringe)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearch, astar::d_ary_heap_fringe<4>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearch, astar::bucket_fringe<>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,102 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// A* vs. HDA* on 15-puzzle instances
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/hda_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <puzzle_instances.hpp>
+
+#include <vector>
+#include <iterator>
+#include <limits>
+
+using namespace cds;
+
+namespace
+{
+	std::vector<n_sq_puzzle<4>> const& hda_puzzles()
+	{
+		static std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(8, 80);
+		return puzzles;
+	}
+}
+
+static void BM_Puzzle4AStar(benchmark::State& state)
+{
+	n_sq_puzzle<4> const goal;
+	astar::search_stats stats;
+
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+
+		for (auto const& puz : hda_puzzles())
+		{
+			std::vector<n_sq_puzzle<4>> path;
+			bool const found = astar::a_star_search(
+				puz,
+				&expand<4>,
+				[&goal](n_sq_puzzle<4> const& p) { return tile_taxicab_dist(p, goal); },
+				[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+				[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expanded/s"] = benchmark::Counter(
+		static_cast<double>(stats.nodes_expanded * state.iterations()), benchmark::Counter::kIsRate);
+	state.counters["expanded/search"] = static_cast<double>(stats.nodes_expanded) / hda_puzzles().size();
+}
+
+static void BM_Puzzle4HDAStar(benchmark::State& state)
+{
+	n_sq_puzzle<4> const goal;
+	unsigned int const num_threads = static_cast<unsigned int>(state.range(0));
+	astar::search_stats stats;
+
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+
+		for (auto const& puz : hda_puzzles())
+		{
+			std::vector<n_sq_puzzle<4>> path;
+			bool const found = astar::hda_star_search(
+				puz,
+				&expand<4>,
+				[&goal](n_sq_puzzle<4> const& p) { return tile_taxicab_dist(p, goal); },
+				[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+				[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<size_t>::max(), num_threads, astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expanded/s"] = benchmark::Counter(
+		static_cast<double>(stats.nodes_expanded * state.iterations()), benchmark::Counter::kIsRate);
+	state.counters["expanded/search"] = static_cast<double>(stats.nodes_expanded) / hda_puzzles().size();
+}
+
+BENCHMARK(BM_Puzzle4AStar)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_Puzzle4HDAStar)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,180 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// IDA* on 8-puzzle and 15-puzzle instances, and parallel IDA* on 15-puzzle instances
+
+#include <benchmark/benchmark.h>
+
+#include <astar/ida_star_search.hpp>
+#include <astar/parallel_ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <puzzle_instances.hpp>
+
+#include <vector>
+#include <iterator>
+#include <limits>
+#include <random>
+
+using namespace cds;
+
+template <typename Policy>
+static void BM_PuzzleIDAStar(benchmark::State& state)
+{
+	n_sq_puzzle<3> const goal;
+
+	std::vector<n_sq_puzzle<3>> puzzles(16);
+	for (size_t i = 0 ; i < puzzles.size() ; i++)
+		puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+	size_t num_expands = 0;
+	size_t num_heuristic_calls = 0;
+
+	for (auto _ : state)
+	{
+		num_expands = 0;
+		num_heuristic_calls = 0;
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<3>> path;
+			bool const found = astar::ida_star_search<Policy>(
+				puz,
+				[&num_expands](n_sq_puzzle<3> const& p) { num_expands++; return expand<3>(p); },
+				[&goal, &num_heuristic_calls](n_sq_puzzle<3> const& p)
+				{
+					num_heuristic_calls++;
+					return tile_taxicab_dist(p, goal);
+				},
+				[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+				[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expands/search"] = static_cast<double>(num_expands) / puzzles.size();
+	state.counters["h_calls/search"] = static_cast<double>(num_heuristic_calls) / puzzles.size();
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar, astar::default_ida_search_policy)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar, astar::ida_search_policy<astar::flat_node_storage>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::NONE>)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<>>)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleIDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>)
+	->Unit(benchmark::kMillisecond);
+
+/// Incremental selects taxicab_heuristic, which computes a successor's
+/// distance from its parent's, rather than tile_taxicab_dist()
+template <typename Policy, bool Incremental = false>
+static void BM_Puzzle4IDAStar(benchmark::State& state)
+{
+	n_sq_puzzle<4> const goal;
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(8, 60);
+
+	auto const heuristic = [&goal]
+	{
+		if constexpr (Incremental)
+			return taxicab_heuristic<4>(goal);
+		else
+			return [&goal](n_sq_puzzle<4> const& p) { return tile_taxicab_dist(p, goal); };
+	}();
+
+	size_t num_expands = 0;
+
+	for (auto _ : state)
+	{
+		num_expands = 0;
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<4>> path;
+			bool const found = astar::ida_star_search<Policy>(
+				puz,
+				[&num_expands](n_sq_puzzle<4> const& p) { num_expands++; return expand<4>(p); },
+				heuristic,
+				[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+				[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expands/search"] = static_cast<double>(num_expands) / puzzles.size();
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStar,
+	astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>, true)
+	->Unit(benchmark::kMillisecond);
+
+static void BM_Puzzle4ParallelIDAStar(benchmark::State& state)
+{
+	using policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>;
+
+	n_sq_puzzle<4> const goal;
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(8, 60);
+	unsigned int const num_threads = static_cast<unsigned int>(state.range(0));
+	size_t const split_depth = static_cast<size_t>(state.range(1));
+
+	astar::search_stats stats;
+
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<4>> path;
+			bool const found = astar::parallel_ida_star_search<policy_t>(
+				puz,
+				&expand<4>,
+				[&goal](n_sq_puzzle<4> const& p) { return tile_taxicab_dist(p, goal); },
+				[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+				[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<size_t>::max(), num_threads, split_depth, astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expands/search"] = static_cast<double>(stats.nodes_expanded) / puzzles.size();
+	state.counters["expanded/s"] = benchmark::Counter(
+		static_cast<double>(stats.nodes_expanded * state.iterations()), benchmark::Counter::kIsRate);
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK(BM_Puzzle4ParallelIDAStar)
+	->ArgsProduct({ { 1, 2, 4, 8, 16, 32 }, { 8 } })
+	->Args({ 1, 0 })
+	->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,176 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Compares the node storage implementations
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/search_context.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <grid_map.hpp>
+
+#include <vector>
+#include <random>
+#include <iterator>
+#include <limits>
+
+using namespace cds;
+
+namespace
+{
+	grid_map const& the_large_grid_map()
+	{
+		static grid_map const map(1024, 1024, 0.1, 4, 4321u);
+		return map;
+	}
+}
+
+template <typename NodeStorage>
+static void BM_GridSearchStorage(benchmark::State& state)
+{
+	using policy_t = astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, NodeStorage>;
+
+	grid_map const& map = the_large_grid_map();
+	grid_cell const goal = map.max_corner();
+
+	for (auto _ : state)
+	{
+		std::vector<grid_cell> path;
+		bool const found = astar::a_star_search<policy_t>(
+			map.min_corner(),
+			[&map](grid_cell const& c) { return map.expand(c); },
+			[&goal](grid_cell const& c) { return grid_map::octile_dist(c, goal); },
+			[&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); },
+			[&goal](grid_cell const& c) { return c == goal; },
+			std::back_inserter(path));
+
+		benchmark::DoNotOptimize(found);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_GridSearchStorage, astar::std_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GridSearchStorage, astar::arena_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GridSearchStorage, astar::flat_node_storage)->Unit(benchmark::kMillisecond);
+
+template <typename NodeStorage>
+static void BM_PuzzleSearchStorage(benchmark::State& state)
+{
+	using policy_t = astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER, NodeStorage>;
+
+	n_sq_puzzle<3> const goal;
+
+	std::vector<n_sq_puzzle<3>> puzzles(16);
+	for (size_t i = 0 ; i < puzzles.size() ; i++)
+		puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<3>> path;
+			bool const found = astar::a_star_search<policy_t>(
+				puz,
+				&expand<3>,
+				[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+				[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+				[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleSearchStorage, astar::std_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchStorage, astar::arena_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchStorage, astar::flat_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchStorage, astar::dense_node_storage<n_sq_puzzle_index<3>>)->Unit(benchmark::kMillisecond);
+
+// Same searches, with the storage reused by a search_context
+template <typename NodeStorage>
+static void BM_PuzzleSearchContextStorage(benchmark::State& state)
+{
+	using policy_t = astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER, NodeStorage>;
+
+	std::vector<n_sq_puzzle<3>> puzzles(16);
+	for (size_t i = 0 ; i < puzzles.size() ; i++)
+		puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+	astar::search_context<n_sq_puzzle<3>, taxicab_heuristic<3>, std::hash<n_sq_puzzle<3>>, policy_t> context;
+	std::vector<n_sq_puzzle<3>> path;
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+		{
+			path.clear();
+			bool const found = context.search(
+				puz,
+				&expand<3>,
+				taxicab_heuristic<3>(),
+				[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+				[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+				std::back_inserter(path));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleSearchContextStorage, astar::std_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchContextStorage, astar::arena_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchContextStorage, astar::flat_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleSearchContextStorage, astar::dense_node_storage<n_sq_puzzle_index<3>>)->Unit(benchmark::kMillisecond);
+
+// Uninformed (zero heuristic) searches, which find most of the 181440 8-puzzle states
+template <typename NodeStorage>
+static void BM_PuzzleUninformedSearchStorage(benchmark::State& state)
+{
+	using policy_t = astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER, NodeStorage>;
+
+	std::vector<n_sq_puzzle<3>> puzzles(4);
+	for (size_t i = 0 ; i < puzzles.size() ; i++)
+		puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+	astar::search_stats stats;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<3>> path;
+			bool const found = astar::a_star_search<policy_t>(
+				puz,
+				&expand<3>,
+				[](n_sq_puzzle<3> const&) { return size_t(0); },
+				[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+				[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+				std::back_inserter(path), nullptr,
+				std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats));
+
+			benchmark::DoNotOptimize(found);
+		}
+	}
+
+	state.counters["expanded/search"] = static_cast<double>(stats.nodes_expanded) / puzzles.size();
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleUninformedSearchStorage, astar::std_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleUninformedSearchStorage, astar::arena_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleUninformedSearchStorage, astar::flat_node_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PuzzleUninformedSearchStorage, astar::dense_node_storage<n_sq_puzzle_index<3>>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Pattern database build time, lookup cost, and IDA* with the
+// pattern database compared to the taxicab distance
+
+#include <benchmark/benchmark.h>
+
+#include <astar/ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <pattern_database.hpp>
+
+#include <puzzle_instances.hpp>
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+using namespace cds;
+
+namespace
+{
+	pattern_database<4> const& the_4x4_database()
+	{
+		static pattern_database<4> const pdb;
+		return pdb;
+	}
+}
+
+template <size_t N>
+static void BM_PatternDatabaseBuild(benchmark::State& state)
+{
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		pattern_database<N> const pdb;
+		bytes = pdb.size_bytes();
+	}
+
+	state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+BENCHMARK_TEMPLATE(BM_PatternDatabaseBuild, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PatternDatabaseBuild, 4)->Unit(benchmark::kMillisecond);
+
+template <bool PDB>
+static void BM_Puzzle4HeuristicLookup(benchmark::State& state)
+{
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(4096, 100);
+	taxicab_heuristic<4> const taxicab;
+	auto const& pdb = the_4x4_database();
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+		{
+			if constexpr (PDB)
+				benchmark::DoNotOptimize(pdb(puz));
+			else
+				benchmark::DoNotOptimize(taxicab(puz));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Puzzle4HeuristicLookup, false);
+BENCHMARK_TEMPLATE(BM_Puzzle4HeuristicLookup, true);
+
+template <bool PDB>
+static void BM_Puzzle4IDAStarHeuristic(benchmark::State& state)
+{
+	using policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>;
+
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(8, 100);
+	auto const& pdb = the_4x4_database();
+
+	astar::search_stats stats;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+
+		for (auto const& puz : puzzles)
+		{
+			auto solve = [&](auto h)
+			{
+				std::vector<n_sq_puzzle<4>> path;
+				return astar::ida_star_search<policy_t>(
+					puz, &expand<4>, h,
+					[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+					[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+					std::back_inserter(path), nullptr,
+					std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats));
+			};
+
+			if constexpr (PDB)
+				benchmark::DoNotOptimize(solve(std::cref(pdb)));
+			else
+				benchmark::DoNotOptimize(solve(taxicab_heuristic<4>()));
+		}
+	}
+
+	state.counters["expanded/search"] = static_cast<double>(stats.nodes_expanded) / puzzles.size();
+}
+
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStarHeuristic, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStarHeuristic, true)->Unit(benchmark::kMillisecond);
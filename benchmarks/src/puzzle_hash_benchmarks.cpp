@@ -0,0 +1,119 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Compares the cost of a hash table lookup of a puzzle state with the
+// n_sq_puzzle hash, and with a hash of the puzzle's state string,
+// and measures the cost of hashing the successors of a puzzle
+
+#include <benchmark/benchmark.h>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <puzzle_instances.hpp>
+
+#include <unordered_set>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace cds;
+
+namespace
+{
+	template <size_t N>
+	struct string_hash
+	{
+		size_t operator()(n_sq_puzzle<N> const& puz) const
+		{
+			return std::hash<std::string>()(puz.state_as_string());
+		}
+	};
+
+	template <size_t N>
+	struct string_less
+	{
+		bool operator()(n_sq_puzzle<N> const& p1, n_sq_puzzle<N> const& p2) const
+		{
+			return p1.state_as_string() < p2.state_as_string();
+		}
+	};
+
+	constexpr size_t theNumPuzzles = 4096;
+}
+
+template <size_t N, typename Hash>
+static void BM_PuzzleHashLookup(benchmark::State& state)
+{
+	std::vector<n_sq_puzzle<N>> const puzzles = random_walk_puzzles<N>(theNumPuzzles, 64);
+	std::unordered_set<n_sq_puzzle<N>, Hash> const puzzle_set(puzzles.begin(), puzzles.end());
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+			benchmark::DoNotOptimize(puzzle_set.find(puz));
+	}
+
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 3, string_hash<3>);
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 3, std::hash<n_sq_puzzle<3>>);
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 4, string_hash<4>);
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 4, std::hash<n_sq_puzzle<4>>);
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 5, string_hash<5>);
+BENCHMARK_TEMPLATE(BM_PuzzleHashLookup, 5, std::hash<n_sq_puzzle<5>>);
+
+template <size_t N, typename Less>
+static void BM_PuzzleOrderedLookup(benchmark::State& state)
+{
+	std::vector<n_sq_puzzle<N>> const puzzles = random_walk_puzzles<N>(theNumPuzzles, 64);
+	std::set<n_sq_puzzle<N>, Less> const puzzle_set(puzzles.begin(), puzzles.end());
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+			benchmark::DoNotOptimize(puzzle_set.find(puz));
+	}
+
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleOrderedLookup, 4, string_less<4>);
+BENCHMARK_TEMPLATE(BM_PuzzleOrderedLookup, 4, std::less<n_sq_puzzle<4>>);
+BENCHMARK_TEMPLATE(BM_PuzzleOrderedLookup, 5, string_less<5>);
+BENCHMARK_TEMPLATE(BM_PuzzleOrderedLookup, 5, std::less<n_sq_puzzle<5>>);
+
+template <size_t N>
+static void BM_PuzzleExpandAndHash(benchmark::State& state)
+{
+	std::vector<n_sq_puzzle<N>> const puzzles = random_walk_puzzles<N>(theNumPuzzles, 64);
+	std::hash<n_sq_puzzle<N>> const hash_fn;
+
+	size_t num_successors = 0;
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+		{
+			for (auto const& adj : expand<N>(puz))
+			{
+				benchmark::DoNotOptimize(hash_fn(adj));
+				num_successors++;
+			}
+		}
+	}
+
+	state.SetItemsProcessed(num_successors);
+}
+
+BENCHMARK_TEMPLATE(BM_PuzzleExpandAndHash, 4);
+BENCHMARK_TEMPLATE(BM_PuzzleExpandAndHash, 5);
@@ -0,0 +1,96 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// The linear conflict and walking distance heuristics compared to the
+// taxicab distance: lookup cost, and IDA* on a fixed set of 15-puzzles
+
+#include <benchmark/benchmark.h>
+
+#include <astar/ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <puzzle_heuristics.hpp>
+
+#include <puzzle_instances.hpp>
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+using namespace cds;
+
+namespace
+{
+	constexpr size_t theNumPuzzles = 100;
+	constexpr size_t theNumMoves = 100;
+}
+
+template <typename Heuristic>
+static void BM_Puzzle4HeuristicEval(benchmark::State& state)
+{
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(4096, 100);
+	Heuristic const h;
+
+	for (auto _ : state)
+	{
+		for (auto const& puz : puzzles)
+			benchmark::DoNotOptimize(h(puz));
+	}
+
+	state.SetItemsProcessed(state.iterations() * puzzles.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Puzzle4HeuristicEval, taxicab_heuristic<4>);
+BENCHMARK_TEMPLATE(BM_Puzzle4HeuristicEval, linear_conflict_heuristic<4>);
+BENCHMARK_TEMPLATE(BM_Puzzle4HeuristicEval, walking_distance_heuristic<4>);
+
+/// Solves the same theNumPuzzles puzzles with each heuristic. The time is for all of them.
+template <typename Heuristic>
+static void BM_Puzzle4IDAStarCompareHeuristics(benchmark::State& state)
+{
+	using policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>;
+
+	std::vector<n_sq_puzzle<4>> const puzzles = random_walk_puzzles<4>(theNumPuzzles, theNumMoves);
+	Heuristic const h;
+
+	astar::search_stats stats;
+	size_t total_cost = 0;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+		total_cost = 0;
+
+		for (auto const& puz : puzzles)
+		{
+			std::vector<n_sq_puzzle<4>> path;
+			size_t cost = 0;
+			benchmark::DoNotOptimize(astar::ida_star_search<policy_t>(
+				puz, &expand<4>, std::cref(h),
+				[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+				[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+				std::back_inserter(path), &cost,
+				std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats)));
+
+			total_cost += cost;
+		}
+	}
+
+	state.counters["expanded/search"] = static_cast<double>(stats.nodes_expanded) / puzzles.size();
+	state.counters["cost/search"] = static_cast<double>(total_cost) / puzzles.size();
+}
+
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStarCompareHeuristics, taxicab_heuristic<4>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStarCompareHeuristics, linear_conflict_heuristic<4>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Puzzle4IDAStarCompareHeuristics, walking_distance_heuristic<4>)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,158 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Repeated point-to-point queries, a_star_search vs. a reused search_context
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/search_context.hpp>
+
+#include <grid_map.hpp>
+#include <alloc_counter.hpp>
+
+#include <array>
+#include <vector>
+#include <random>
+#include <iterator>
+
+using namespace cds;
+
+namespace
+{
+	grid_map const& the_grid_map()
+	{
+		static grid_map const map(256, 256, 0.2, 4, 5678u);
+		return map;
+	}
+
+	std::vector<std::pair<grid_cell, grid_cell>> const& the_queries()
+	{
+		static std::vector<std::pair<grid_cell, grid_cell>> const queries = []
+		{
+			grid_map const& map = the_grid_map();
+
+			std::mt19937 gen(42);
+			std::uniform_int_distribution<int> x_dist(0, map.width() - 1);
+			std::uniform_int_distribution<int> y_dist(0, map.height() - 1);
+
+			auto random_open_cell = [&]
+			{
+				grid_cell c;
+				do
+				{
+					c = grid_cell{ x_dist(gen), y_dist(gen) };
+				} while (!map.is_open(c));
+
+				return c;
+			};
+
+			std::vector<std::pair<grid_cell, grid_cell>> q;
+			for (int i = 0 ; i < 32 ; i++)
+				q.emplace_back(random_open_cell(), random_open_cell());
+
+			return q;
+		}();
+
+		return queries;
+	}
+
+	// Octile distance to a goal cell, as a named type so that it can be
+	// a search_context template argument
+	struct octile_heuristic
+	{
+		grid_cell goal;
+
+		double operator()(grid_cell const& c) const { return grid_map::octile_dist(c, goal); }
+	};
+
+	// Map expansion into a fixed size buffer, so that the benchmark
+	// measures the allocations made by the search itself
+	struct grid_neighbors
+	{
+		std::array<grid_cell, 8> cells;
+		size_t count = 0;
+
+		grid_cell const* begin() const { return cells.data(); }
+		grid_cell const* end() const { return cells.data() + count; }
+	};
+
+	grid_neighbors expand_cell(grid_map const& map, grid_cell const& c)
+	{
+		grid_neighbors neighbors;
+		for (int dy = -1 ; dy <= 1 ; dy++)
+			for (int dx = -1 ; dx <= 1 ; dx++)
+				if ((dx != 0 || dy != 0) && map.is_open(grid_cell{c.x + dx, c.y + dy}))
+					neighbors.cells[neighbors.count++] = grid_cell{c.x + dx, c.y + dy};
+
+		return neighbors;
+	}
+
+	template <typename SearchFn>
+	void run_queries(benchmark::State& state, SearchFn search_fn)
+	{
+		grid_map const& map = the_grid_map();
+		auto const& queries = the_queries();
+
+		std::vector<grid_cell> path;
+		path.reserve(map.width() * map.height());
+
+		auto expand = [&map](grid_cell const& c) { return expand_cell(map, c); };
+		auto weight = [&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); };
+
+		auto run_all = [&]
+		{
+			for (auto const& q : queries)
+			{
+				path.clear();
+				bool const found = search_fn(
+					q.first, expand, octile_heuristic{q.second}, weight,
+					[goal = q.second](grid_cell const& c) { return c == goal; },
+					std::back_inserter(path));
+
+				benchmark::DoNotOptimize(found);
+			}
+		};
+
+		run_all();	// warm up
+
+		size_t const allocations_before = allocation_count();
+		for (auto _ : state)
+			run_all();
+
+		size_t const num_queries = state.iterations() * queries.size();
+		state.counters["allocs/query"] = static_cast<double>(allocation_count() - allocations_before) / num_queries;
+		state.counters["queries/s"] = benchmark::Counter(static_cast<double>(num_queries), benchmark::Counter::kIsRate);
+	}
+}
+
+static void BM_RepeatedQueriesAStarSearch(benchmark::State& state)
+{
+	run_queries(state, [](auto&&... args)
+		{
+			return astar::a_star_search<astar::context_search_policy>(args...);
+		});
+}
+
+BENCHMARK(BM_RepeatedQueriesAStarSearch)->Unit(benchmark::kMillisecond);
+
+static void BM_RepeatedQueriesSearchContext(benchmark::State& state)
+{
+	astar::search_context<grid_cell, octile_heuristic> context;
+
+	run_queries(state, [&context](auto&&... args)
+		{
+			return context.search(args...);
+		});
+}
+
+BENCHMARK(BM_RepeatedQueriesSearchContext)->Unit(benchmark::kMillisecond);
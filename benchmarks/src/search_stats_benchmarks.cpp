@@ -0,0 +1,82 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Cost of collecting search_stats, compared to the default (null) observer
+
+#include <benchmark/benchmark.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <grid_map.hpp>
+
+#include <vector>
+#include <iterator>
+#include <limits>
+
+using namespace cds;
+
+namespace
+{
+	grid_map const& the_grid_map()
+	{
+		static grid_map const map(256, 256, 0.25, 4, 1234u);
+		return map;
+	}
+
+	template <typename Observer>
+	bool search_grid(grid_map const& map, Observer observer)
+	{
+		grid_cell const goal = map.max_corner();
+
+		std::vector<grid_cell> path;
+		return astar::a_star_search<astar::search_policy<astar::binary_heap_fringe>>(
+			map.min_corner(),
+			[&map](grid_cell const& c) { return map.expand(c); },
+			[&goal](grid_cell const& c) { return grid_map::octile_dist(c, goal); },
+			[&map](grid_cell const& c1, grid_cell const& c2) { return map.weight(c1, c2); },
+			[&goal](grid_cell const& c) { return c == goal; },
+			std::back_inserter(path),
+			nullptr,
+			std::numeric_limits<double>::max(),
+			observer);
+	}
+}
+
+static void BM_GridSearchNullObserver(benchmark::State& state)
+{
+	grid_map const& map = the_grid_map();
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(search_grid(map, astar::null_search_observer()));
+}
+
+static void BM_GridSearchStatsObserver(benchmark::State& state)
+{
+	grid_map const& map = the_grid_map();
+
+	astar::search_stats stats;
+	for (auto _ : state)
+	{
+		stats = astar::search_stats();
+		benchmark::DoNotOptimize(search_grid(map, astar::search_stats_observer(stats)));
+	}
+
+	state.counters["expanded"] = static_cast<double>(stats.nodes_expanded);
+	state.counters["generated"] = static_cast<double>(stats.nodes_generated);
+	state.counters["stale"] = static_cast<double>(stats.stale_entries);
+	state.counters["peak_nodes"] = static_cast<double>(stats.peak_num_nodes);
+	state.counters["peak_fringe"] = static_cast<double>(stats.peak_fringe_size);
+}
+
+BENCHMARK(BM_GridSearchNullObserver)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GridSearchStatsObserver)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,111 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Read-only memory mapped file
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NSQ_HAVE_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace cds
+{
+
+/// A file mapped read-only into memory. Pages are read from the file when they
+/// are first touched, and processes that map the same file share the page cache.
+/// Where mmap() isn't available, the file is read into memory instead.
+class mapped_file
+{
+#ifdef NSQ_HAVE_MMAP
+	void* m_data = MAP_FAILED;
+#else
+	std::vector<uint8_t> m_buffer;
+#endif
+	size_t m_size = 0;
+
+public:
+	/// @throws std::runtime_error if the file can't be opened or mapped
+	explicit mapped_file(std::string const& path)
+	{
+#ifdef NSQ_HAVE_MMAP
+		int const fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error("Can't open " + path);
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0)
+		{
+			::close(fd);
+			throw std::runtime_error("Can't stat " + path);
+		}
+
+		m_size = static_cast<size_t>(st.st_size);
+		if (m_size > 0)
+			m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+
+		// The mapping keeps the file open
+		::close(fd);
+
+		if (m_size > 0 && m_data == MAP_FAILED)
+			throw std::runtime_error("Can't map " + path);
+
+		// Lookups are all over the place, so don't read ahead
+		if (m_size > 0)
+			::madvise(m_data, m_size, MADV_RANDOM);
+#else
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+			throw std::runtime_error("Can't open " + path);
+
+		m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		m_size = m_buffer.size();
+#endif
+	}
+
+	mapped_file(mapped_file const&) = delete;
+	mapped_file& operator=(mapped_file const&) = delete;
+
+	~mapped_file()
+	{
+#ifdef NSQ_HAVE_MMAP
+		if (m_data != MAP_FAILED)
+			::munmap(m_data, m_size);
+#endif
+	}
+
+	uint8_t const* data() const
+	{
+#ifdef NSQ_HAVE_MMAP
+		return m_size > 0 ? static_cast<uint8_t const*>(m_data) : nullptr;
+#else
+		return m_buffer.data();
+#endif
+	}
+
+	size_t size() const { return m_size; }
+};
+
+} // namespace cds
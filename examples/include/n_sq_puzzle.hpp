@@ -16,6 +16,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <optional>
+#include <vector>
 #include <random>
 #include <tuple>
 #include <utility>
@@ -61,6 +68,192 @@ constexpr size_t num_digits()
 	return digits;
 }
 
+inline uint32_t bit_count(uint32_t x)
+{
+	x = x - ((x >> 1) & 0x55555555u);
+	x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+	return (((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+constexpr size_t factorial(size_t n)
+{
+	size_t f = 1;
+	for (size_t i = 2 ; i <= n ; i++)
+		f *= i;
+
+	return f;
+}
+
+/// (M - 1 - k)! for k in [0, M), the number of orders of the items after the kth item of M
+template <size_t M>
+constexpr std::array<size_t, M> factorial_weights()
+{
+	std::array<size_t, M> weights{};
+	for (size_t k = 0 ; k < M ; k++)
+		weights[k] = factorial(M - 1 - k);
+
+	return weights;
+}
+
+/// Random keys for Zobrist hashing of puzzles with N*N tiles, one for each
+/// tile at each position. The empty space's keys are 0, so moving a tile
+/// changes the hash by two keys.
+template <size_t N>
+constexpr std::array<uint64_t, N*N*N*N> make_zobrist_keys()
+{
+	std::array<uint64_t, N*N*N*N> keys{};
+
+	// splitmix64, so the keys are the same on every run
+	uint64_t x = 0x2545F4914F6CDD1Dull;
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{
+		if (i % (N * N) == 0)
+			continue;	// empty space
+
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		keys[i] = z ^ (z >> 31);
+	}
+
+	return keys;
+}
+
+/// Puzzle tiles in a plain array, for puzzles that are too big to pack.
+/// Keeps a Zobrist hash of the tiles, which moving a tile updates in O(1).
+template <size_t N>
+class array_tiles
+{
+public:
+	using state_t = std::array<int, N*N>;
+
+private:
+	static constexpr std::array<uint64_t, N*N*N*N> zobrist_keys = make_zobrist_keys<N>();
+
+	static uint64_t zobrist_key(size_t index, int tile) { return zobrist_keys[N * N * index + tile]; }
+
+	state_t m_tiles;
+	uint64_t m_hash = 0;
+
+public:
+	array_tiles() = default;
+
+	explicit array_tiles(state_t const& state)
+		: m_tiles(state)
+	{
+		for (size_t i = 0 ; i < N * N ; i++)
+			m_hash ^= zobrist_key(i, m_tiles[i]);
+	}
+
+	int get(size_t index) const { return m_tiles[index]; }
+
+	/// Moves the tile at index into the empty space at space_index
+	void move_tile(size_t index, size_t space_index)
+	{
+		int const tile = m_tiles[index];
+		m_hash ^= zobrist_key(index, tile) ^ zobrist_key(space_index, tile);
+
+		std::swap(m_tiles[index], m_tiles[space_index]);
+	}
+
+	size_t index_of(int tile) const
+	{
+		return std::distance(m_tiles.begin(), std::find(m_tiles.begin(), m_tiles.end(), tile));
+	}
+
+	state_t to_state() const { return m_tiles; }
+
+	size_t hash() const { return static_cast<size_t>(m_hash); }
+
+	bool operator==(array_tiles const& rhs) const { return m_hash == rhs.m_hash && m_tiles == rhs.m_tiles; }
+
+	/// Lexicographic order of the tiles
+	bool operator<(array_tiles const& rhs) const { return m_tiles < rhs.m_tiles; }
+};
+
+/// Puzzle tiles packed into a 64 bit word, 4 bits per tile, (the tile at index i
+/// is in bits [4i, 4i + 4)) for puzzles up to 4x4. Moving a tile is a couple of
+/// shifts and masks, and comparing two puzzles is a single integer compare.
+template <size_t N>
+class packed_tiles
+{
+	static_assert(N * N <= 16, "Too many tiles to pack into 64 bits");
+
+public:
+	using state_t = std::array<int, N*N>;
+
+private:
+	uint64_t m_word = 0;
+
+	static constexpr uint64_t tile_mask = 0xF;
+
+public:
+	packed_tiles() = default;
+
+	explicit packed_tiles(state_t const& state)
+	{
+		for (size_t i = 0 ; i < N * N ; i++)
+			m_word |= static_cast<uint64_t>(state[i]) << (4 * i);
+	}
+
+	int get(size_t index) const { return static_cast<int>((m_word >> (4 * index)) & tile_mask); }
+
+	/// Moves the tile at index into the empty space at space_index
+	void move_tile(size_t index, size_t space_index)
+	{
+		// The empty space is 0, so this clears the tile's old position and sets the new one
+		uint64_t const tile = (m_word >> (4 * index)) & tile_mask;
+		m_word ^= (tile << (4 * index)) | (tile << (4 * space_index));
+	}
+
+	size_t index_of(int tile) const
+	{
+		size_t i = 0;
+		while (i < N * N && get(i) != tile)
+			i++;
+
+		return i;
+	}
+
+	state_t to_state() const
+	{
+		state_t state;
+		for (size_t i = 0 ; i < N * N ; i++)
+			state[i] = get(i);
+
+		return state;
+	}
+
+	uint64_t word() const { return m_word; }
+
+	size_t hash() const
+	{
+		uint64_t const h = m_word * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+
+	bool operator==(packed_tiles const& rhs) const { return m_word == rhs.m_word; }
+
+	/// Lexicographic order of the tiles. The first tile is in the low bits,
+	/// so compare the lowest tile that differs rather than the whole word.
+	bool operator<(packed_tiles const& rhs) const
+	{
+		uint64_t const diff = m_word ^ rhs.m_word;
+		if (diff == 0)
+			return false;
+
+		size_t lowest_bit = 0;
+		while (((diff >> lowest_bit) & 1) == 0)
+			lowest_bit++;
+
+		size_t const shift = lowest_bit & ~size_t(3);
+		return ((m_word >> shift) & tile_mask) < ((rhs.m_word >> shift) & tile_mask);
+	}
+};
+
+template <size_t N>
+using tiles_t = std::conditional_t<(N <= 4), packed_tiles<N>, array_tiles<N>>;
+
 } // n_sq_puz_detail
 
 template <size_t N>
@@ -71,9 +264,9 @@ public:
 	using state_t = std::array<int, N*N>;
 
 private:
-	state_t	m_state;
+	n_sq_puz_detail_::tiles_t<N> m_tiles;
 
-	size_t m_space_index;	// Index of empty space in puzzle (0 in m_state)
+	size_t m_space_index;	// Index of empty space in puzzle (0 in m_tiles)
 
 	std::pair<size_t, size_t> row_col_from_index(size_t idx) const
 	{
@@ -98,8 +291,8 @@ private:
 	bool is_even_permutation_of_(state_t const& state) const
 	{
 		std::vector< std::vector<int> > state_cycle_decomp;
-		if (!cycle_decomposition(m_state, state, std::back_inserter(state_cycle_decomp)))
-			return false;	// state is not a permutation of m_state
+		if (!cycle_decomposition(get_state(), state, std::back_inserter(state_cycle_decomp)))
+			return false;	// state is not a permutation of this puzzle's state
 
 		size_t const permutation_order =
 			std::accumulate(state_cycle_decomp.begin(), state_cycle_decomp.end(), 0,
@@ -121,14 +314,20 @@ public:
 	/// Creates a n_sq_puzzle in the solved configuration.
 	/// Use shuffle() to shuffle the puzzle state to a random configuration.
 	n_sq_puzzle()
-		: m_state(n_sq_puz_detail_::create_index_array<int, N * N>())
 	{
-		std::rotate(m_state.begin(), m_state.begin() + 1, m_state.end());
+		state_t state = n_sq_puz_detail_::create_index_array<int, N * N>();
+		std::rotate(state.begin(), state.begin() + 1, state.end());
+
+		m_tiles = n_sq_puz_detail_::tiles_t<N>(state);
 		m_space_index = N * N - 1;
 	}
 
 	bool set(state_t const& state)
 	{
+		// Out of range tiles would index past the tile tables
+		if (std::any_of(state.begin(), state.end(), [](int tile) { return tile < 0 || tile >= static_cast<int>(N * N); }))
+			return false;
+
 		auto space_it = std::find(state.begin(), state.end(), 0);
 		if (space_it == state.end())
 			return false;
@@ -137,16 +336,16 @@ public:
 
 		// First, move the empty space (0 element) to the lower right corner
 		n_sq_puzzle<N> test_puz;
-		test_puz.m_state = state;
+		test_puz.m_tiles = n_sq_puz_detail_::tiles_t<N>(state);
 		test_puz.m_space_index = space_index;
 
 		test_puz.move_space_to_lower_right_();
 
-		bool const is_even_permutation = is_even_permutation_of_(test_puz.m_state);
+		bool const is_even_permutation = is_even_permutation_of_(test_puz.get_state());
 
 		if (is_even_permutation)
 		{
-			m_state = state;
+			m_tiles = n_sq_puz_detail_::tiles_t<N>(state);
 			m_space_index = space_index;
 		}
 
@@ -155,22 +354,20 @@ public:
 
 	static constexpr size_t size() { return N; }
 
-	int& operator()(size_t i, size_t j) { return m_state[N * i + j]; }
-	const int& operator()(size_t i, size_t j) const { return m_state[N * i + j]; }
+	int operator()(size_t i, size_t j) const { return m_tiles.get(N * i + j); }
 
 	std::pair<size_t, size_t> get_space_ij() const { return row_col_from_index(m_space_index); }
 
 	std::pair<size_t, size_t> get_ij_of(int item) const
 	{
-		auto item_it = std::find(m_state.begin(), m_state.end(), item);
-		if (item_it == m_state.end())
+		size_t const index = m_tiles.index_of(item);
+		if (index == N * N)
 			std::terminate();	// whatever
 
-		size_t const index = std::distance(m_state.begin(), item_it);
 		return row_col_from_index(index);
 	}
 
-	const state_t& get_state() const { return m_state; }
+	state_t get_state() const { return m_tiles.to_state(); }
 
 	bool operator==(const std::array< std::array<int, N>, N> & rhs) const
 	{
@@ -184,7 +381,7 @@ public:
 
 	bool operator==(const n_sq_puzzle<N>& rhs) const
 	{
-		return m_state == rhs.m_state;
+		return m_tiles == rhs.m_tiles;
 	}
 
 	bool operator!=(const n_sq_puzzle<N>& rhs) const
@@ -195,15 +392,23 @@ public:
 	std::string state_as_string() const
 	{
 		std::stringstream ss;
-		for (auto i : m_state)
-			ss << i;
+		for (size_t i = 0 ; i < N * N ; i++)
+			ss << m_tiles.get(i);
 
 		return ss.str();
 	}
 
+	/// Hash of the puzzle state, in O(1). Packed puzzles hash their packed word,
+	/// larger ones return the Zobrist hash that move() keeps up to date.
+	size_t hash() const
+	{
+		return m_tiles.hash();
+	}
+
+	/// Lexicographic order of the puzzle states
 	bool operator<(const n_sq_puzzle<N>& rhs) const
 	{
-		return this->state_as_string() < rhs.state_as_string();
+		return m_tiles < rhs.m_tiles;
 	}
 
 	bool is_solved() const
@@ -211,6 +416,97 @@ public:
 		return *this == n_sq_puzzle<N>();
 	}
 
+	/// Number of states that can be reached from the solved puzzle: the space
+	/// can be anywhere, and the tiles (in reading order) can be in half of
+	/// their orders, which half depending on the space's position.
+	static constexpr size_t num_states()
+	{
+		static_assert(N <= 4, "Too many puzzle states to rank");
+		return N * N * (n_sq_puz_detail_::factorial(N * N - 1) / 2);
+	}
+
+	/// Perfect hash of the states that can be reached from the solved puzzle, to [0, num_states()).
+	/// The space's position, and the lexicographic rank of the order of the tiles, halved.
+	/// (Moving a tile up or down moves it past N - 1 others, so the tiles' parity is the same
+	/// for every state with the space in the same position, and just one of each pair
+	/// of orders that only differ in their last two tiles can be reached)
+	size_t rank() const
+	{
+		constexpr size_t num_tiles = N * N - 1;
+		constexpr auto weights = n_sq_puz_detail_::factorial_weights<num_tiles>();
+
+		// Sum of the number of smaller tiles that come after each tile, times the
+		// number of orders of the tiles after it. (The space adds 0) The terms don't
+		// depend on each other, so this doesn't wait on a chain of multiplies.
+		size_t tiles_rank = 0;
+		uint32_t placed = 0;
+		for (size_t index = 0 ; index < N * N ; index++)
+		{
+			uint32_t const tile = static_cast<uint32_t>(m_tiles.get(index));
+			uint32_t const smaller = tile == 0 ? 0 : tile - 1 - n_sq_puz_detail_::bit_count(placed & ((1u << tile) - 2));
+			size_t const k = std::min(index - (index > m_space_index), num_tiles - 1);
+
+			tiles_rank += smaller * weights[k];
+			placed |= 1u << tile;
+		}
+
+		return m_space_index * (n_sq_puz_detail_::factorial(num_tiles) / 2) + tiles_rank / 2;
+	}
+
+	/// The state with rank r, the inverse of rank()
+	static n_sq_puzzle<N> unrank(size_t r)
+	{
+		constexpr size_t num_tiles = N * N - 1;
+		constexpr size_t half_orders = n_sq_puz_detail_::factorial(num_tiles) / 2;
+
+		size_t const space_index = r / half_orders;
+		size_t tiles_rank = 2 * (r % half_orders);
+
+		// Digits of the tiles' rank, (each is the number of smaller tiles that come
+		// after its tile) from the last tile to the first. The last two digits are 0
+		// and 0 or 1, and their sum's parity is the parity of the tiles' order.
+		std::array<size_t, num_tiles> smaller{};
+		size_t parity = 0;
+		for (size_t k = num_tiles ; k-- > 0 ; )
+		{
+			smaller[k] = tiles_rank % (num_tiles - k);
+			tiles_rank /= num_tiles - k;
+			parity += smaller[k];
+		}
+
+		// The solved puzzle's tiles are in order, with the space in the last row
+		size_t const space_row = space_index / N;
+		if (parity % 2 != (N % 2 == 0 ? (N - 1 - space_row) % 2 : 0))
+			smaller[num_tiles - 2] = 1;
+
+		state_t state;
+		uint32_t placed = 0;
+		for (size_t index = 0, k = 0 ; index < N * N ; index++)
+		{
+			if (index == space_index)
+			{
+				state[index] = 0;
+				continue;
+			}
+
+			// The tile with smaller[k] smaller tiles that haven't been placed yet
+			int tile = 0;
+			for (size_t count = 0 ; count <= smaller[k] ; )
+				if (!(placed & (1u << ++tile)))
+					count++;
+
+			state[index] = tile;
+			placed |= 1u << tile;
+			k++;
+		}
+
+		n_sq_puzzle<N> puz;
+		puz.m_tiles = n_sq_puz_detail_::tiles_t<N>(state);
+		puz.m_space_index = space_index;
+
+		return puz;
+	}
+
 	bool shuffle(std::optional<unsigned int> seed = std::nullopt)
 	{
 		if (!seed.has_value())
@@ -240,20 +536,21 @@ protected:
 		if (m_space_index != N*N - 1)
 			throw std::runtime_error("Error moving empty space for permutation configuration!");
 
-		auto shuffled_state = n_sq_puzzle<N>().m_state;
+		auto shuffled_state = n_sq_puzzle<N>().get_state();
+		auto const state = get_state();
 
 		bool is_even_permutation = false;
 		while (!is_even_permutation)
 		{
 			std::mt19937 gen(seed_fn());
 			std::shuffle(shuffled_state.begin(), shuffled_state.end() - 1, gen);
-			if (shuffled_state == m_state)
+			if (shuffled_state == state)
 				continue;
 
 			is_even_permutation = is_even_permutation_of_(shuffled_state);
 		}
 
-		m_state = shuffled_state;
+		m_tiles = n_sq_puz_detail_::tiles_t<N>(shuffled_state);
 		m_space_index = N*N - 1;
 
 		// Finally, move the space index to a random position 
@@ -316,26 +613,26 @@ public:
 		size_t i,j;
 		std::tie(i,j) = row_col_from_index(m_space_index);
 
+		size_t tile_index = m_space_index;
 		switch (mt)
 		{
 		case MoveType::UP:
-			std::swap((*this)(i, j), (*this)(i-1, j));
-			m_space_index = N * (i - 1) + j;
+			tile_index = N * (i - 1) + j;
 			break;
 		case MoveType::DOWN:
-			std::swap((*this)(i, j), (*this)(i+1, j));
-			m_space_index = N * (i+1) + j;
+			tile_index = N * (i+1) + j;
 			break;
 		case MoveType::LEFT:
-			std::swap((*this)(i, j), (*this)(i, j-1));
-			m_space_index = N * i + (j - 1);
+			tile_index = N * i + (j - 1);
 			break;
 		case MoveType::RIGHT:
-			std::swap((*this)(i, j), (*this)(i, j+1));
-			m_space_index = N * i + (j + 1);
+			tile_index = N * i + (j + 1);
 			break;
 		}
 
+		m_tiles.move_tile(tile_index, m_space_index);
+		m_space_index = tile_index;
+
 		return true;
 	}
 
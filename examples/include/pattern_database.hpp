@@ -0,0 +1,522 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Additive pattern database heuristic for the n^2 - 1 puzzle.
+// The tiles are split into disjoint patterns. For each pattern, a table holds the
+// number of moves of the pattern's tiles it takes to get them to their goal
+// positions, from every placement of them. These are found by a breadth-first search
+// back from the goal. Only moves of a pattern's own tiles count, so the tables can
+// be added together.
+// The tables can be saved to a file, and mapped back into memory with open(), so they
+// don't have to be built on every run. A file is only read as lookups touch its pages.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <mapped_file.hpp>
+
+namespace cds
+{
+
+namespace pdb_detail_
+{
+	// Pattern database file layout, in native byte order: a file_header, a file_pattern
+	// for each pattern, then the patterns' tables, each at a page aligned offset.
+	// Bump file_version when the layout, or the meaning of the tables, changes.
+
+	constexpr char file_magic[8] = { 'N', 'S', 'Q', 'P', 'D', 'B', '\0', '\0' };
+	constexpr uint32_t file_version = 1;
+	constexpr uint64_t file_alignment = 4096;
+
+	struct file_header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t dim;
+		uint32_t num_patterns;
+		uint32_t reserved;
+		uint64_t checksum;	// of all of the tables, in order
+	};
+
+	struct file_pattern
+	{
+		uint32_t num_tiles;
+		uint8_t tiles[32];
+		uint32_t reserved;
+		uint64_t offset;
+		uint64_t num_bytes;
+	};
+
+	static_assert(sizeof(file_header) == 32 && sizeof(file_pattern) == 56, "Unexpected pattern database file layout");
+
+	/// FNV-1a, continued from h
+	inline uint64_t checksum(uint64_t h, uint8_t const* data, size_t size)
+	{
+		for (size_t i = 0 ; i < size ; i++)
+			h = (h ^ data[i]) * 0x100000001B3ull;
+
+		return h;
+	}
+
+	constexpr uint64_t checksum_seed = 0xCBF29CE484222325ull;
+}
+
+/// Additive pattern database for n_sq_puzzle<N>, estimates the number of moves to the solved puzzle.
+/// Each move of a pattern's tile changes that tile's taxicab distance by one, so the
+/// number of moves in a pattern's table is its tiles' taxicab distance plus an even
+/// excess. The tables store half of the excess, in 4 bits (capped at 15, so the
+/// estimate never goes over), indexed by a perfect hash of the tiles' positions.
+/// The estimate is the taxicab distance of the puzzle plus twice the excess of each pattern.
+/// The tables can be large, so the database can't be copied. The searches copy
+/// their cost to goal function, so pass it by reference, e.g. with std::cref().
+template <size_t N>
+class pattern_database
+{
+	static_assert(N * N <= 32, "Puzzle is too big for a pattern database");
+
+public:
+	using pattern_t = std::vector<int>;
+	using partition_t = std::vector<pattern_t>;
+
+private:
+	static constexpr size_t num_cells = N * N;
+
+	using positions_t = std::array<uint8_t, num_cells>;
+
+	struct pattern_table
+	{
+		pattern_t tiles;
+		uint8_t const* entries;	// half of the excess moves, two entries per byte
+		size_t num_bytes;
+
+		uint8_t get(size_t index) const { return (entries[index / 2] >> (4 * (index % 2))) & 0xF; }
+	};
+
+	std::vector<pattern_table> m_tables;
+	std::vector<std::vector<uint8_t>> m_built_tables;	// the tables, if they were built
+	std::unique_ptr<mapped_file> m_file;					// or the file they're in
+	taxicab_heuristic<N> m_taxicab;
+
+	struct open_tag {};
+	explicit pattern_database(open_tag) {}
+
+	/// Most states that build_table() can search, it keeps a byte for each one.
+	/// (Patterns of up to 6 tiles for the 15-puzzle, a 7-tile pattern would take 922M)
+	static constexpr size_t max_build_states = size_t(1) << 28;
+
+	/// Number of placements of num_tiles tiles
+	static size_t num_placements(size_t num_tiles)
+	{
+		size_t count = 1;
+		for (size_t i = 0 ; i < num_tiles ; i++)
+			count *= num_cells - i;
+
+		return count;
+	}
+
+	/// Number of states that build_table() searches for a pattern of num_tiles tiles,
+	/// (placements of the tiles and the space) or max_build_states + 1 if there are
+	/// more than that, without overflowing
+	static size_t num_build_states(size_t num_tiles)
+	{
+		size_t count = num_cells;
+		for (size_t i = 0 ; i < num_tiles && count <= max_build_states ; i++)
+			count *= num_cells - i;
+
+		return std::min(count, max_build_states + 1);
+	}
+
+	/// Perfect hash of the positions of num_tiles tiles, (positions[i] is the position of
+	/// the pattern's i-th tile) each position is numbered among the ones that are still free
+	static size_t rank(positions_t const& positions, size_t num_tiles)
+	{
+		size_t r = 0;
+		uint32_t used = 0;
+		for (size_t i = 0 ; i < num_tiles ; i++)
+		{
+			uint32_t const p = positions[i];
+			r = r * (num_cells - i) + (p - n_sq_puz_detail_::bit_count(used & ((1u << p) - 1)));
+			used |= 1u << p;
+		}
+
+		return r;
+	}
+
+	static void unrank(size_t r, size_t num_tiles, positions_t& positions)
+	{
+		positions_t digits{};
+		for (size_t i = num_tiles ; i-- > 0 ; )
+		{
+			digits[i] = static_cast<uint8_t>(r % (num_cells - i));
+			r /= num_cells - i;
+		}
+
+		uint32_t used = 0;
+		for (size_t i = 0 ; i < num_tiles ; i++)
+		{
+			uint8_t p = 0;
+			for (uint8_t free_count = 0 ; ; p++)
+			{
+				if (!(used & (1u << p)) && free_count++ == digits[i])
+					break;
+			}
+
+			positions[i] = p;
+			used |= 1u << p;
+		}
+	}
+
+	/// Taxicab distance of a pattern's tiles to their goal positions
+	static size_t pattern_taxicab_dist(pattern_t const& tiles, positions_t const& positions)
+	{
+		size_t dist = 0;
+		for (size_t i = 0 ; i < tiles.size() ; i++)
+		{
+			int const goal = tiles[i] - 1;
+			int const p = positions[i];
+			dist += std::abs(p / static_cast<int>(N) - goal / static_cast<int>(N)) +
+				std::abs(p % static_cast<int>(N) - goal % static_cast<int>(N));
+		}
+
+		return dist;
+	}
+
+	/// @throws std::invalid_argument if the patterns' tiles aren't distinct puzzle tiles,
+	///			or a pattern has too many tiles to build its table
+	static void check_partition(partition_t const& partition)
+	{
+		uint32_t all_tiles = 0;
+		for (pattern_t const& pattern : partition)
+		{
+			if (num_build_states(pattern.size()) > max_build_states)
+				throw std::invalid_argument("Pattern database pattern has too many tiles");
+
+			for (int tile : pattern)
+			{
+				if (tile < 1 || tile >= static_cast<int>(num_cells) || (all_tiles & (1u << tile)))
+					throw std::invalid_argument("Pattern database tiles have to be distinct puzzle tiles");
+
+				all_tiles |= 1u << tile;
+			}
+		}
+	}
+
+	static std::vector<uint8_t> build_table(pattern_t const& tiles)
+	{
+		size_t const num_tiles = tiles.size();
+		size_t const count = num_placements(num_tiles);
+
+		// Breadth-first search over the placements of the pattern's tiles and the
+		// empty space, (a state is rank * num_cells + space position) where moving
+		// the space over a tile that isn't in the pattern is free. So all of the
+		// positions the space can get to for free are visited along with a state.
+		std::vector<uint8_t> moves(count * num_cells, 0xFF);
+		std::vector<size_t> layer, next_layer;
+
+		positions_t positions{};
+		for (size_t i = 0 ; i < num_tiles ; i++)
+			positions[i] = static_cast<uint8_t>(tiles[i] - 1);
+
+		size_t const goal_state = rank(positions, num_tiles) * num_cells + num_cells - 1;
+		moves[goal_state] = 0;
+		layer.push_back(goal_state);
+
+		std::vector<size_t> spaces;
+		for (uint8_t layer_moves = 0 ; !layer.empty() ; layer_moves++)
+		{
+			for (size_t const state : layer)
+			{
+				if (moves[state] != layer_moves)
+					continue;	// Reached with fewer moves after it was added
+
+				size_t const r = state / num_cells;
+				unrank(r, num_tiles, positions);
+
+				std::array<int, num_cells> tile_at;
+				tile_at.fill(-1);
+				for (size_t i = 0 ; i < num_tiles ; i++)
+					tile_at[positions[i]] = static_cast<int>(i);
+
+				spaces.assign(1, state % num_cells);
+				while (!spaces.empty())
+				{
+					size_t const space = spaces.back();
+					spaces.pop_back();
+
+					auto move_space = [&](size_t to)
+					{
+						if (tile_at[to] < 0)
+						{
+							size_t const next = r * num_cells + to;
+							if (moves[next] > layer_moves)
+							{
+								moves[next] = layer_moves;
+								spaces.push_back(to);
+							}
+
+							return;
+						}
+
+						positions_t next_positions = positions;
+						next_positions[tile_at[to]] = static_cast<uint8_t>(space);
+
+						size_t const next = rank(next_positions, num_tiles) * num_cells + to;
+						if (moves[next] > layer_moves + 1)
+						{
+							moves[next] = layer_moves + 1;
+							next_layer.push_back(next);
+						}
+					};
+
+					if (space >= N) move_space(space - N);
+					if (space + N < num_cells) move_space(space + N);
+					if (space % N > 0) move_space(space - 1);
+					if (space % N < N - 1) move_space(space + 1);
+				}
+			}
+
+			layer.swap(next_layer);
+			next_layer.clear();
+		}
+
+		std::vector<uint8_t> entries((count + 1) / 2, 0);
+		for (size_t r = 0 ; r < count ; r++)
+		{
+			uint8_t min_moves = 0xFF;
+			for (size_t space = 0 ; space < num_cells ; space++)
+				min_moves = std::min(min_moves, moves[r * num_cells + space]);
+
+			unrank(r, num_tiles, positions);
+			size_t const half_excess = std::min<size_t>((min_moves - pattern_taxicab_dist(tiles, positions)) / 2, 15);
+			entries[r / 2] |= static_cast<uint8_t>(half_excess << (4 * (r % 2)));
+		}
+
+		return entries;
+	}
+
+public:
+	/// Splits the tiles into patterns of up to 5 tiles, of about the same size,
+	/// (e.g. 4-4 for the 8-puzzle, 5-5-5 for the 15-puzzle) in the order of the tiles
+	static partition_t default_partition()
+	{
+		size_t const num_tiles = num_cells - 1;
+		size_t const num_patterns = (num_tiles + 4) / 5;
+
+		partition_t partition(num_patterns);
+		for (size_t t = 0 ; t < num_tiles ; t++)
+			partition[t * num_patterns / num_tiles].push_back(static_cast<int>(t + 1));
+
+		return partition;
+	}
+
+	/// Builds the tables for each pattern in partition. Tiles that aren't
+	/// in any pattern add their taxicab distance to the estimate.
+	explicit pattern_database(partition_t const& partition = default_partition())
+	{
+		check_partition(partition);
+
+		m_built_tables.reserve(partition.size());
+		for (pattern_t const& pattern : partition)
+		{
+			m_built_tables.push_back(build_table(pattern));
+			m_tables.push_back(pattern_table{ pattern, m_built_tables.back().data(), m_built_tables.back().size() });
+		}
+	}
+
+	pattern_database(pattern_database&&) = default;
+	pattern_database& operator=(pattern_database&&) = default;
+
+	/// Maps the tables in a file written by save(). Nothing but the header
+	/// is read until lookups touch the tables, and the checksum isn't checked
+	/// (that reads the whole file) until verify_checksum() is called.
+	/// @throws std::runtime_error if the file can't be mapped, or isn't
+	///			a pattern database for this puzzle size, in this version
+	static pattern_database open(std::string const& path)
+	{
+		using namespace pdb_detail_;
+
+		pattern_database pdb{ open_tag{} };
+		pdb.m_file = std::make_unique<mapped_file>(path);
+
+		uint8_t const* const data = pdb.m_file->data();
+		size_t const size = pdb.m_file->size();
+
+		auto invalid_file = [&path](char const* what)
+		{
+			return std::runtime_error(path + ": " + what);
+		};
+
+		file_header header;
+		if (size < sizeof(header))
+			throw invalid_file("Not a pattern database file");
+
+		std::memcpy(&header, data, sizeof(header));
+		if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0)
+			throw invalid_file("Not a pattern database file");
+		if (header.version != file_version)
+			throw invalid_file("Unsupported pattern database version");
+		if (header.dim != N)
+			throw invalid_file("Pattern database is for a different puzzle size");
+		if (header.num_patterns > num_cells || size < sizeof(header) + header.num_patterns * sizeof(file_pattern))
+			throw invalid_file("Truncated pattern database");
+
+		partition_t partition;
+		for (uint32_t i = 0 ; i < header.num_patterns ; i++)
+		{
+			file_pattern fp;
+			std::memcpy(&fp, data + sizeof(header) + i * sizeof(fp), sizeof(fp));
+
+			if (fp.num_tiles >= num_cells)
+				throw invalid_file("Invalid pattern");
+
+			pattern_t tiles(fp.tiles, fp.tiles + fp.num_tiles);
+			partition.push_back(tiles);
+
+			if (fp.num_bytes != (num_placements(fp.num_tiles) + 1) / 2 || fp.offset > size || size - fp.offset < fp.num_bytes)
+				throw invalid_file("Truncated pattern database");
+
+			pdb.m_tables.push_back(pattern_table{ std::move(tiles), data + fp.offset, static_cast<size_t>(fp.num_bytes) });
+		}
+
+		try
+		{
+			check_partition(partition);
+		}
+		catch (std::invalid_argument const&)
+		{
+			throw invalid_file("Invalid pattern");
+		}
+
+		return pdb;
+	}
+
+	/// Writes the tables to path, in the format that open() reads
+	/// @throws std::runtime_error if the file can't be written
+	void save(std::string const& path) const
+	{
+		using namespace pdb_detail_;
+
+		file_header header{};
+		std::memcpy(header.magic, file_magic, sizeof(file_magic));
+		header.version = file_version;
+		header.dim = N;
+		header.num_patterns = static_cast<uint32_t>(m_tables.size());
+		header.checksum = compute_checksum();
+
+		std::vector<file_pattern> patterns;
+		uint64_t offset = sizeof(header) + m_tables.size() * sizeof(file_pattern);
+		for (pattern_table const& table : m_tables)
+		{
+			offset = (offset + file_alignment - 1) / file_alignment * file_alignment;
+
+			file_pattern fp{};
+			fp.num_tiles = static_cast<uint32_t>(table.tiles.size());
+			std::copy(table.tiles.begin(), table.tiles.end(), fp.tiles);
+			fp.offset = offset;
+			fp.num_bytes = table.num_bytes;
+			patterns.push_back(fp);
+
+			offset += table.num_bytes;
+		}
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		out.write(reinterpret_cast<char const*>(patterns.data()), patterns.size() * sizeof(file_pattern));
+
+		for (size_t i = 0 ; i < m_tables.size() ; i++)
+		{
+			std::vector<char> const padding(patterns[i].offset - static_cast<uint64_t>(out.tellp()), 0);
+			out.write(padding.data(), padding.size());
+			out.write(reinterpret_cast<char const*>(m_tables[i].entries), m_tables[i].num_bytes);
+		}
+
+		if (!out.flush())
+			throw std::runtime_error("Can't write " + path);
+	}
+
+	/// Checksum of the tables
+	uint64_t compute_checksum() const
+	{
+		uint64_t h = pdb_detail_::checksum_seed;
+		for (pattern_table const& table : m_tables)
+			h = pdb_detail_::checksum(h, table.entries, table.num_bytes);
+
+		return h;
+	}
+
+	/// Whether the tables of a database that was opened from a file match the
+	/// checksum in the file's header. (Always true for a database that was built.)
+	/// Reads all of the tables.
+	bool verify_checksum() const
+	{
+		if (!m_file)
+			return true;
+
+		pdb_detail_::file_header header;
+		std::memcpy(&header, m_file->data(), sizeof(header));
+		return header.checksum == compute_checksum();
+	}
+
+	/// Estimated number of moves to solve p
+	size_t operator()(n_sq_puzzle<N> const& p) const
+	{
+		positions_t tile_positions;
+		for (size_t i = 0 ; i < N ; i++)
+			for (size_t j = 0 ; j < N ; j++)
+				tile_positions[p(i, j)] = static_cast<uint8_t>(N * i + j);
+
+		size_t excess = 0;
+		for (pattern_table const& table : m_tables)
+		{
+			positions_t positions{};
+			for (size_t i = 0 ; i < table.tiles.size() ; i++)
+				positions[i] = tile_positions[table.tiles[i]];
+
+			excess += table.get(rank(positions, table.tiles.size()));
+		}
+
+		return m_taxicab(p) + 2 * excess;
+	}
+
+	/// Size of the tables, in bytes
+	size_t size_bytes() const
+	{
+		size_t bytes = 0;
+		for (pattern_table const& table : m_tables)
+			bytes += table.num_bytes;
+
+		return bytes;
+	}
+
+	partition_t partition() const
+	{
+		partition_t partition;
+		for (pattern_table const& table : m_tables)
+			partition.push_back(table.tiles);
+
+		return partition;
+	}
+};
+
+} // namespace cds
@@ -0,0 +1,414 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Admissible heuristics for the n-squared puzzle that are stronger than the
+// taxicab distance, but don't need a pattern database: the taxicab distance
+// plus linear conflicts, and the walking distance. Both look up precomputed
+// tables for each row and column of the puzzle.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+namespace cds
+{
+	namespace heuristics_detail_
+	{
+		constexpr size_t pow(size_t base, size_t exp)
+		{
+			size_t p = 1;
+			for (size_t i = 0 ; i < exp ; i++)
+				p *= base;
+
+			return p;
+		}
+	}
+
+	/// The taxicab distance, plus two moves for each tile that has to be removed from a row
+	/// (or column) to let the other tiles in it that belong in it pass each other.
+	/// The conflicts in each line are looked up in a table, by the goal positions of its
+	/// tiles. A move only changes the order of the tiles in two rows, (if it's up or down)
+	/// or in two columns, so a successor's distance can be computed from its parent's in O(N).
+	template <size_t N>
+	class linear_conflict_heuristic
+	{
+		// Each position in a line holds 0, or a tile's goal position in the line + 1
+		static constexpr size_t num_line_indices = heuristics_detail_::pow(N + 1, N);
+
+		using line_digits_t = std::array< std::array<uint16_t, N*N>, N >;
+
+		taxicab_heuristic<N> m_taxicab;
+		line_digits_t m_row_digits;	// what each tile adds to the line index of each row
+		line_digits_t m_col_digits;	// and of each column
+		std::vector<uint8_t> m_line_conflicts;	// tiles to remove from a line, by its line index
+
+		static std::vector<uint8_t> build_line_conflicts()
+		{
+			std::vector<uint8_t> line_conflicts(num_line_indices);
+			for (size_t index = 0 ; index < num_line_indices ; index++)
+			{
+				std::array<size_t, N> goal_pos;
+				size_t num_tiles = 0;
+				for (size_t r = index ; r != 0 ; r /= N + 1)
+				{
+					if (r % (N + 1) != 0)
+						goal_pos[num_tiles++] = r % (N + 1);
+				}
+
+				// The tiles that stay are the longest sequence of them that's in order
+				std::array<size_t, N> longest;
+				size_t max_longest = 0;
+				for (size_t t = 0 ; t < num_tiles ; t++)
+				{
+					longest[t] = 1;
+					for (size_t s = 0 ; s < t ; s++)
+						if (goal_pos[s] < goal_pos[t])
+							longest[t] = std::max(longest[t], longest[s] + 1);
+
+					max_longest = std::max(max_longest, longest[t]);
+				}
+
+				line_conflicts[index] = static_cast<uint8_t>(num_tiles - max_longest);
+			}
+
+			return line_conflicts;
+		}
+
+		size_t row_conflicts(n_sq_puzzle<N> const& p, size_t i) const
+		{
+			size_t index = 0;
+			for (size_t j = N ; j-- > 0 ; )
+				index = index * (N + 1) + m_row_digits[i][p(i, j)];
+
+			return m_line_conflicts[index];
+		}
+
+		size_t col_conflicts(n_sq_puzzle<N> const& p, size_t j) const
+		{
+			size_t index = 0;
+			for (size_t i = N ; i-- > 0 ; )
+				index = index * (N + 1) + m_col_digits[j][p(i, j)];
+
+			return m_line_conflicts[index];
+		}
+
+	public:
+		explicit linear_conflict_heuristic(n_sq_puzzle<N> const& goal = n_sq_puzzle<N>())
+			: m_taxicab(goal)
+			, m_row_digits{}
+			, m_col_digits{}
+			, m_line_conflicts(build_line_conflicts())
+		{
+			for (size_t i = 0 ; i < N ; i++)
+			{
+				for (size_t j = 0 ; j < N ; j++)
+				{
+					// The space is never in conflict
+					if (int const tile = goal(i, j))
+					{
+						m_row_digits[i][tile] = static_cast<uint16_t>(j + 1);
+						m_col_digits[j][tile] = static_cast<uint16_t>(i + 1);
+					}
+				}
+			}
+		}
+
+		size_t operator()(n_sq_puzzle<N> const& p) const
+		{
+			size_t conflicts = 0;
+			for (size_t k = 0 ; k < N ; k++)
+				conflicts += row_conflicts(p, k) + col_conflicts(p, k);
+
+			return m_taxicab(p) + 2 * conflicts;
+		}
+
+		/// Distance of p, a successor of parent, whose distance is parent_dist
+		size_t operator()(n_sq_puzzle<N> const& parent, size_t parent_dist, n_sq_puzzle<N> const& p) const
+		{
+			// The tile moved from where the space is now, to where it was in parent
+			auto const [from_i, from_j] = p.get_space_ij();
+			auto const [to_i, to_j] = parent.get_space_ij();
+
+			size_t const dist = m_taxicab(parent, parent_dist, p);
+			if (from_i != to_i)
+			{
+				return dist + 2 * (row_conflicts(p, from_i) + row_conflicts(p, to_i))
+					- 2 * (row_conflicts(parent, from_i) + row_conflicts(parent, to_i));
+			}
+
+			return dist + 2 * (col_conflicts(p, from_j) + col_conflicts(p, to_j))
+				- 2 * (col_conflicts(parent, from_j) + col_conflicts(parent, to_j));
+		}
+	};
+
+	/// Walking distance: the number of moves needed to get every tile into its goal row,
+	/// if tiles could move up or down into the space's row from anywhere in the next row,
+	/// plus the same number for the columns. (Which is at least the taxicab distance)
+	/// A row's state is how many of its tiles belong in each row. All of these states are
+	/// found by a breadth first search from the goal when the heuristic is constructed,
+	/// and ranked, so their distances and the states that each move leads to are kept in
+	/// flat tables. The ranks of recently evaluated puzzles are remembered, (per thread)
+	/// so a successor's distance is usually a couple of table reads from its parent's ranks.
+	template <size_t N>
+	class walking_distance_heuristic
+	{
+		static_assert(N <= 4, "Walking distance states are packed into 64 bits");
+
+		// N x N counts of the tiles in each line by their goal line, 3 bits each.
+		// The line with the space is the one whose counts add up to N - 1.
+		using line_state_t = uint64_t;
+		using rank_t = uint16_t;	// 24964 states for N = 4
+
+		static constexpr size_t count_bits = 3;
+		static constexpr size_t memo_bits = 10;
+
+		/// The line states that can be reached from the goal's, ranked in the order they're found
+		struct line_table
+		{
+			// Open addressing table of each state (in the upper 48 bits) and its rank
+			std::vector<uint64_t> ranks;
+			size_t shift;
+			std::vector<uint8_t> dists;
+			// Rank of the state after a tile moves into the space's line, by the rank,
+			// the side the tile came from, (0 for the line before, 1 for the one after)
+			// and the tile's goal line
+			std::vector<rank_t> next;
+		};
+
+		/// A puzzle, and the ranks of its row and column states for heuristic id
+		struct memo_entry
+		{
+			uint64_t id = 0;
+			n_sq_puzzle<N> puzzle;
+			rank_t row = 0;
+			rank_t col = 0;
+		};
+
+		uint64_t m_id;	// memo entries are only used by the heuristic (and copies) that made them
+		std::array<int, N*N> m_goal_i;	// goal row of each tile
+		std::array<int, N*N> m_goal_j;	// goal column of each tile
+		line_table m_rows;
+		line_table m_cols;
+
+		static line_state_t count_bit(size_t line, size_t goal_line)
+		{
+			return line_state_t(1) << (count_bits * (N * line + goal_line));
+		}
+
+		static size_t count(line_state_t state, size_t line, size_t goal_line)
+		{
+			return (state >> (count_bits * (N * line + goal_line))) & ((1 << count_bits) - 1);
+		}
+
+		static size_t rank_slot(line_table const& table, line_state_t state)
+		{
+			return (state * 0x9E3779B97F4A7C15ull) >> table.shift;
+		}
+
+		static rank_t rank(line_table const& table, line_state_t state)
+		{
+			size_t const mask = table.ranks.size() - 1;
+			for (size_t i = rank_slot(table, state) ; ; i = (i + 1) & mask)
+			{
+				if ((table.ranks[i] >> 16) == state)
+					return static_cast<rank_t>(table.ranks[i]);
+
+				if (table.ranks[i] == 0)
+					throw std::out_of_range("Walking distance state can't be reached from the goal");
+			}
+		}
+
+		static line_table build_table(line_state_t goal_state, size_t goal_space_line)
+		{
+			std::unordered_map<line_state_t, rank_t> ranks{ { goal_state, rank_t(0) } };
+			std::vector<line_state_t> states{ goal_state };
+			std::vector<size_t> space_lines{ goal_space_line };
+
+			line_table table;
+			table.dists.push_back(0);
+
+			for (size_t r = 0 ; r < states.size() ; r++)
+			{
+				line_state_t const state = states[r];
+				size_t const space_line = space_lines[r];
+				uint8_t const next_dist = table.dists[r] + 1;
+
+				// Move a tile from the next line over into the space's line
+				for (size_t line : { space_line - 1, space_line + 1 })
+				{
+					if (line >= N)
+						continue;
+
+					for (size_t goal_line = 0 ; goal_line < N ; goal_line++)
+					{
+						if (count(state, line, goal_line) == 0)
+							continue;
+
+						line_state_t const next = state - count_bit(line, goal_line) + count_bit(space_line, goal_line);
+						if (ranks.emplace(next, static_cast<rank_t>(states.size())).second)
+						{
+							states.push_back(next);
+							space_lines.push_back(line);
+							table.dists.push_back(next_dist);
+						}
+					}
+				}
+			}
+
+			// Fill the rank table to at most half
+			size_t num_slots = 1;
+			table.shift = 64;
+			while (num_slots < 2 * states.size())
+			{
+				num_slots *= 2;
+				table.shift--;
+			}
+
+			table.ranks.resize(num_slots);
+			for (size_t r = 0 ; r < states.size() ; r++)
+			{
+				size_t i = rank_slot(table, states[r]);
+				while (table.ranks[i] != 0)
+					i = (i + 1) & (num_slots - 1);
+
+				table.ranks[i] = (states[r] << 16) | r;
+			}
+
+			table.next.resize(states.size() * 2 * N);
+			for (size_t r = 0 ; r < states.size() ; r++)
+			{
+				for (size_t side = 0 ; side < 2 ; side++)
+				{
+					size_t const line = side == 0 ? space_lines[r] - 1 : space_lines[r] + 1;
+					if (line >= N)
+						continue;
+
+					for (size_t goal_line = 0 ; goal_line < N ; goal_line++)
+					{
+						if (count(states[r], line, goal_line) != 0)
+						{
+							line_state_t const next = states[r] - count_bit(line, goal_line) + count_bit(space_lines[r], goal_line);
+							table.next[(r * 2 + side) * N + goal_line] = ranks.at(next);
+						}
+					}
+				}
+			}
+
+			return table;
+		}
+
+		static uint64_t next_id()
+		{
+			static std::atomic<uint64_t> id{1};
+			return id++;
+		}
+
+		static memo_entry& memo(n_sq_puzzle<N> const& p)
+		{
+			thread_local std::vector<memo_entry> entries(size_t(1) << memo_bits);
+			return entries[(uint64_t(p.hash()) * 0x9E3779B97F4A7C15ull) >> (64 - memo_bits)];
+		}
+
+		line_state_t row_state(n_sq_puzzle<N> const& p) const
+		{
+			line_state_t state = 0;
+			for (size_t i = 0 ; i < N ; i++)
+				for (size_t j = 0 ; j < N ; j++)
+					if (int const tile = p(i, j))
+						state += count_bit(i, m_goal_i[tile]);
+
+			return state;
+		}
+
+		line_state_t col_state(n_sq_puzzle<N> const& p) const
+		{
+			line_state_t state = 0;
+			for (size_t i = 0 ; i < N ; i++)
+				for (size_t j = 0 ; j < N ; j++)
+					if (int const tile = p(i, j))
+						state += count_bit(j, m_goal_j[tile]);
+
+			return state;
+		}
+
+		/// The ranks of p's row and column states, from the memo if they're in it
+		std::pair<rank_t, rank_t> memo_ranks(n_sq_puzzle<N> const& p) const
+		{
+			memo_entry& e = memo(p);
+			if (e.id != m_id || !(e.puzzle == p))
+				e = memo_entry{ m_id, p, rank(m_rows, row_state(p)), rank(m_cols, col_state(p)) };
+
+			return std::make_pair(e.row, e.col);
+		}
+
+	public:
+		explicit walking_distance_heuristic(n_sq_puzzle<N> const& goal = n_sq_puzzle<N>())
+			: m_id(next_id())
+		{
+			for (size_t i = 0 ; i < N ; i++)
+			{
+				for (size_t j = 0 ; j < N ; j++)
+				{
+					m_goal_i[goal(i, j)] = static_cast<int>(i);
+					m_goal_j[goal(i, j)] = static_cast<int>(j);
+				}
+			}
+
+			auto const [space_i, space_j] = goal.get_space_ij();
+			m_rows = build_table(row_state(goal), space_i);
+			m_cols = build_table(col_state(goal), space_j);
+		}
+
+		/// Number of reachable row and column states
+		size_t num_states() const { return m_rows.dists.size() + m_cols.dists.size(); }
+
+		size_t operator()(n_sq_puzzle<N> const& p) const
+		{
+			return m_rows.dists[rank(m_rows, row_state(p))] + m_cols.dists[rank(m_cols, col_state(p))];
+		}
+
+		/// Distance of p, a successor of parent. (The distance is looked up from
+		/// parent's ranks, so parent_dist isn't needed)
+		size_t operator()(n_sq_puzzle<N> const& parent, size_t parent_dist, n_sq_puzzle<N> const& p) const
+		{
+			(void)parent_dist;
+
+			// The tile moved from where the space is now, to where it was in parent.
+			// That only changes the rows' state, (if it moved up or down) or the columns'.
+			auto const [from_i, from_j] = p.get_space_ij();
+			auto const [to_i, to_j] = parent.get_space_ij();
+			int const tile = p(to_i, to_j);
+
+			auto [row, col] = memo_ranks(parent);
+			if (from_i != to_i)
+				row = m_rows.next[(row * 2 + (from_i < to_i ? 0 : 1)) * N + m_goal_i[tile]];
+			else
+				col = m_cols.next[(col * 2 + (from_j < to_j ? 0 : 1)) * N + m_goal_j[tile]];
+
+			// p is likely to be expanded soon
+			memo(p) = memo_entry{ m_id, p, row, col };
+
+			return m_rows.dists[row] + m_cols.dists[col];
+		}
+	};
+}
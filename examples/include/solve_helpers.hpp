@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdlib>
 #include <utility>
 #include <vector>
 
@@ -19,27 +21,67 @@
 
 namespace cds
 {
+	/// Sum of the taxicab (Manhattan) distances of the tiles to their positions in a goal puzzle.
+	/// A move only changes the distance of the tile that moved, so the distance of
+	/// a successor can also be computed from the distance of its parent in O(1).
 	template <size_t N>
-	size_t tile_taxicab_dist(const n_sq_puzzle<N>& p, const n_sq_puzzle<N>& goal)
+	class taxicab_heuristic
 	{
-		size_t taxicab_sum = 0;
+		std::array<int, N*N> m_goal_i;	// goal row of each tile
+		std::array<int, N*N> m_goal_j;	// goal column of each tile
 
-		// start at 1, since we don't want to include the empty space
-		for (size_t i = 1 ; i < (N*N) ; i++)
+		size_t tile_dist(int tile, int i, int j) const
 		{
-			int i_p, j_p;
-			std::tie(i_p, j_p) = p.get_ij_of(i);
+			return std::abs(m_goal_i[tile] - i) + std::abs(m_goal_j[tile] - j);
+		}
 
-			int i_goal, j_goal;
-			std::tie(i_goal, j_goal) = goal.get_ij_of(i);
+	public:
+		explicit taxicab_heuristic(n_sq_puzzle<N> const& goal = n_sq_puzzle<N>())
+		{
+			for (size_t i = 0 ; i < N ; i++)
+			{
+				for (size_t j = 0 ; j < N ; j++)
+				{
+					m_goal_i[goal(i, j)] = static_cast<int>(i);
+					m_goal_j[goal(i, j)] = static_cast<int>(j);
+				}
+			}
+		}
 
-			size_t const taxicab_x = std::abs(i_goal - i_p);
-			size_t const taxicab_y = std::abs(j_goal - j_p);
+		size_t operator()(n_sq_puzzle<N> const& p) const
+		{
+			size_t taxicab_sum = 0;
+			for (size_t i = 0 ; i < N ; i++)
+			{
+				for (size_t j = 0 ; j < N ; j++)
+				{
+					// Don't include the empty space
+					if (int const tile = p(i, j))
+						taxicab_sum += tile_dist(tile, static_cast<int>(i), static_cast<int>(j));
+				}
+			}
+
+			return taxicab_sum;
+		}
 
-			taxicab_sum += (taxicab_x + taxicab_y);
+		/// Distance of p, a successor of parent, whose distance is parent_dist
+		size_t operator()(n_sq_puzzle<N> const& parent, size_t parent_dist, n_sq_puzzle<N> const& p) const
+		{
+			// The tile moved from where the space is now, to where it was in parent
+			auto const [from_i, from_j] = p.get_space_ij();
+			auto const [to_i, to_j] = parent.get_space_ij();
+
+			int const tile = p(to_i, to_j);
+			return parent_dist
+				- tile_dist(tile, static_cast<int>(from_i), static_cast<int>(from_j))
+				+ tile_dist(tile, static_cast<int>(to_i), static_cast<int>(to_j));
 		}
+	};
 
-		return taxicab_sum;
+	template <size_t N>
+	size_t tile_taxicab_dist(const n_sq_puzzle<N>& p, const n_sq_puzzle<N>& goal)
+	{
+		return taxicab_heuristic<N>(goal)(p);
 	}
 
 	template <size_t N>
@@ -57,6 +99,16 @@ namespace cds
 		return next_states;
 	}
 
+	/// Perfect hash of the puzzle states, for astar::dense_node_storage, which has an entry
+	/// for every state. (So it's only practical for puzzles up to 3x3, with 181440 states)
+	template <size_t N>
+	struct n_sq_puzzle_index
+	{
+		size_t size() const { return n_sq_puzzle<N>::num_states(); }
+
+		size_t operator()(n_sq_puzzle<N> const& p) const { return p.rank(); }
+	};
+
 	template <size_t Dim>
 	void add_puzzle_state(std::vector<n_sq_puzzle<Dim>>& states, typename n_sq_puzzle<Dim>::state_t const& state)
 	{
@@ -74,8 +126,7 @@ namespace std
 	public:
 		size_t operator()(cds::n_sq_puzzle<N> const& puz) const
 		{
-			hash<std::string> hash_fn;
-			return hash_fn(puz.state_as_string());
+			return puz.hash();
 		}
 	};
 }
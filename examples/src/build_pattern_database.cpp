@@ -0,0 +1,131 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Builds the pattern database for an n-squared puzzle, and saves it to a file
+// that solve_n_sq_puzzle can load with --pdb_file
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <chrono>
+
+#include <pattern_database.hpp>
+
+using namespace std;
+using cds::pattern_database;
+
+struct build_options
+{
+	size_t dim = 4;
+	std::string out_file;
+	std::vector< std::vector<int> > partition;	// the default partition, if empty
+};
+
+template <size_t N>
+bool build_pattern_database(build_options const& options)
+{
+	using ms_t = std::chrono::duration<double, std::milli>;
+
+	try
+	{
+		auto const build_start = std::chrono::steady_clock::now();
+		pattern_database<N> const pdb(options.partition.empty() ?
+			pattern_database<N>::default_partition() : options.partition);
+		auto const build_time = std::chrono::steady_clock::now() - build_start;
+
+		pdb.save(options.out_file);
+
+		// Read it back, to make sure that it was written correctly
+		if (!pattern_database<N>::open(options.out_file).verify_checksum())
+		{
+			std::cerr << options.out_file << ": checksum mismatch" << endl;
+			return false;
+		}
+
+		cout << options.out_file << ": " << pdb.partition().size() << " patterns, " << pdb.size_bytes()
+			<< " bytes, built in " << ms_t(build_time).count() << " ms" << endl;
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool parse_cmd_line(int argc, char** argv, build_options& options)
+{
+	for (int arg = 1 ; arg < argc ; arg++)
+	{
+		if ((arg + 1) >= argc)
+		{
+			std::cerr << "Option requires argument: " << argv[arg] << endl;
+			return false;
+		}
+
+		if (strcmp(argv[arg], "--dim") == 0)
+		{
+			options.dim = atoi(argv[++arg]);
+		}
+		else if (strcmp(argv[arg], "--out") == 0)
+		{
+			options.out_file = argv[++arg];
+		}
+		else if (strcmp(argv[arg], "--pattern") == 0)
+		{
+			// Tiles separated by spaces, e.g. "1 2 3 4"
+			std::istringstream iss(argv[++arg]);
+			options.partition.emplace_back(std::istream_iterator<int>{iss}, std::istream_iterator<int>());
+		}
+		else
+		{
+			std::cout << "Unknown command line argument: " << argv[arg] << endl;
+			return false;
+		}
+	}
+
+	if (options.out_file.empty())
+	{
+		std::cerr << "Usage: " << argv[0] << " --out <file> [--dim <n>] [--pattern \"<tiles>\" ...]" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	build_options options;
+	if (!parse_cmd_line(argc, argv, options))
+		return 1;
+
+	bool success = false;
+	switch (options.dim)
+	{
+	case 3:
+		success = build_pattern_database<3>(options);
+		break;
+	case 4:
+		success = build_pattern_database<4>(options);
+		break;
+	default:
+		std::cout << "Unsupported puzzle dimension " << options.dim << endl;
+	}
+
+	return success ? 0 : 1;
+}
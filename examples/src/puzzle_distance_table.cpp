@@ -0,0 +1,133 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Computes the exact distance to the goal of every state of an n-squared puzzle,
+// with a breadth first search from the goal, and saves the distances to a file.
+// The file has one byte per state, in n_sq_puzzle::rank() order.
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <chrono>
+
+#include <astar/breadth_first_search.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+using namespace std;
+using cds::n_sq_puzzle;
+
+struct table_options
+{
+	size_t dim = 3;
+	std::string out_file;
+	unsigned int num_threads = 0;	// hardware concurrency, if 0
+};
+
+template <size_t N>
+bool build_distance_table(table_options const& options)
+{
+	using seconds_t = std::chrono::duration<double>;
+
+	size_t const num_states = n_sq_puzzle<N>::num_states();
+	std::vector<uint8_t> distances(num_states, cds::astar::unreachable_distance);
+
+	auto const start = std::chrono::steady_clock::now();
+	std::vector<size_t> const layer_sizes = cds::astar::breadth_first_layers(
+		n_sq_puzzle<N>(), num_states, &cds::expand<N>,
+		[](n_sq_puzzle<N> const& p) { return p.rank(); },
+		&n_sq_puzzle<N>::unrank,
+		[&distances](size_t r, size_t depth) { distances[r] = static_cast<uint8_t>(depth); },
+		options.num_threads);
+	seconds_t const elapsed = std::chrono::steady_clock::now() - start;
+
+	for (size_t depth = 0 ; depth < layer_sizes.size() ; depth++)
+		cout << depth << ": " << layer_sizes[depth] << endl;
+
+	size_t const num_reached = std::accumulate(layer_sizes.begin(), layer_sizes.end(), size_t(0));
+	cout << num_reached << " of " << num_states << " states, max depth " << layer_sizes.size() - 1
+		<< ", " << elapsed.count() << " s (" << num_reached / elapsed.count() << " states/s)" << endl;
+
+	if (!options.out_file.empty())
+	{
+		std::ofstream out(options.out_file, std::ios::binary);
+		out.write(reinterpret_cast<char const*>(distances.data()), distances.size());
+		if (!out)
+		{
+			std::cerr << options.out_file << ": write failed" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool parse_cmd_line(int argc, char** argv, table_options& options)
+{
+	for (int arg = 1 ; arg < argc ; arg++)
+	{
+		if ((arg + 1) >= argc)
+		{
+			std::cerr << "Option requires argument: " << argv[arg] << endl;
+			return false;
+		}
+
+		if (strcmp(argv[arg], "--dim") == 0)
+		{
+			options.dim = atoi(argv[++arg]);
+		}
+		else if (strcmp(argv[arg], "--out") == 0)
+		{
+			options.out_file = argv[++arg];
+		}
+		else if (strcmp(argv[arg], "--threads") == 0)
+		{
+			options.num_threads = atoi(argv[++arg]);
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--dim <n>] [--out <file>] [--threads <n>]" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	table_options options;
+	if (!parse_cmd_line(argc, argv, options))
+		return 1;
+
+	bool success = false;
+	switch (options.dim)
+	{
+	case 2:
+		success = build_distance_table<2>(options);
+		break;
+	case 3:
+		success = build_distance_table<3>(options);
+		break;
+	default:
+		// The 15-puzzle has too many states to rank into a table
+		std::cout << "Unsupported puzzle dimension " << options.dim << endl;
+	}
+
+	return success ? 0 : 1;
+}
@@ -16,21 +16,28 @@
 #include <algorithm>
 #include <functional>
 #include <numeric>
-#include <list>
 #include <cstring>
 #include <string>
 #include <iterator>
 #include <sstream>
 #include <optional>
+#include <chrono>
 
 #include <n_sq_puzzle.hpp>
 #include <solve_helpers.hpp>
+#include <pattern_database.hpp>
+#include <puzzle_heuristics.hpp>
 #include <astar/a_star_search.hpp>
 #include <astar/ida_star_search.hpp>
+#include <astar/search_stats.hpp>
 
 using namespace std;
 using namespace cds::astar;
 using cds::n_sq_puzzle;
+using cds::taxicab_heuristic;
+using cds::pattern_database;
+using cds::linear_conflict_heuristic;
+using cds::walking_distance_heuristic;
 namespace ph = std::placeholders;
 
 template <size_t N>
@@ -75,6 +82,9 @@ enum class HeuristicType
 {
 	MISPLACED,	// # of misplaced tiles
 	TAXICAB,		// distance between tiles in X and Y ("Manhattan" distance)
+	LINEAR_CONFLICT,	// taxicab distance plus linear conflicts
+	WALKING_DISTANCE,	// moves to get the tiles into their rows, plus into their columns
+	PDB,			// additive pattern database
 	ZERO			// null heuristic (always return 0)
 };
 
@@ -83,8 +93,10 @@ struct puzzle_options
 	size_t dim = 3;
 	size_t max_cost = std::numeric_limits<size_t>::max();
 	bool use_ida = false;
+	bool print_stats = false;
 	std::vector<int> puzzle_state;
 	std::optional<size_t> shuffle_seed;
+	std::string pdb_file;	// pattern database to load, instead of building it
 
 	HeuristicType heuristic_type = HeuristicType::TAXICAB;
 };
@@ -127,36 +139,82 @@ bool solve_n_sq_puzzle(puzzle_options const& options)
 	std::cout << "Start puzzle state:" << endl << puz << endl << endl;
 	std::cout << "Goal puzzle state:" << endl << puz_solved << endl << endl;
 
-	std::list<puzzle_t> solve_steps;
+	std::vector<puzzle_t> solve_steps;
 
-	std::function<size_t(puzzle_t const&)> h_fn;
+	auto goal_fn = [](puzzle_t const& p) { return p.is_solved(); };
+
+	auto solve = [&](auto h_fn, auto observer)
+	{
+		if (options.use_ida)
+		{
+			return ida_star_search(
+				puz, &expand<Dim>, h_fn, neighbor_dist<Dim>{}, goal_fn,
+				std::back_inserter(solve_steps), nullptr, options.max_cost, observer);
+		}
+
+		return a_star_search(
+			puz, &expand<Dim>, h_fn, neighbor_dist<Dim>{}, goal_fn,
+			std::back_inserter(solve_steps), nullptr, options.max_cost, observer);
+	};
+
+	search_stats stats;
+	auto solve_with = [&](auto h_fn)
+	{
+		return options.print_stats ?
+			solve(h_fn, search_stats_observer(stats)) : solve(h_fn, null_search_observer());
+	};
+
+	bool success = false;
 	switch (options.heuristic_type)
 	{
 	case HeuristicType::MISPLACED:
-		h_fn = [&puz_solved](puzzle_t const& puz) { return misplaced_tiles<N>(puz, puz_solved); };
+		success = solve_with([&puz_solved](puzzle_t const& puz) { return misplaced_tiles<N>(puz, puz_solved); });
 		break;
 	case HeuristicType::TAXICAB:
-		h_fn = [&puz_solved](puzzle_t const& puz) { return tile_taxicab_dist(puz, puz_solved); };
+		// Updates the distance from the parent's for each successor
+		success = solve_with(taxicab_heuristic<N>(puz_solved));
 		break;
-	case HeuristicType::ZERO:
-		h_fn = [](puzzle_t const&) { return 0; };
+	case HeuristicType::LINEAR_CONFLICT:
+	{
+		linear_conflict_heuristic<N> const h(puz_solved);
+		success = solve_with(std::cref(h));
 		break;
 	}
-
-	auto goal_fn = [](puzzle_t const& p) { return p.is_solved(); };
-
-	bool success = false;
-	if (options.use_ida)
+	case HeuristicType::WALKING_DISTANCE:
 	{
-		success = ida_star_search(
-			puz, &expand<Dim>, h_fn, neighbor_dist<Dim>{}, goal_fn,
-			std::back_inserter(solve_steps), nullptr, options.max_cost);
+		walking_distance_heuristic<N> const h(puz_solved);
+		success = solve_with(std::cref(h));
+		break;
 	}
-	else
+	case HeuristicType::PDB:
 	{
-		success = a_star_search(
-			puz, &expand<Dim>, h_fn, neighbor_dist<Dim>{}, goal_fn,
-			std::back_inserter(solve_steps), nullptr, options.max_cost);
+		using ms_t = std::chrono::duration<double, std::milli>;
+
+		auto const build_start = std::chrono::steady_clock::now();
+		std::optional< pattern_database<N> > pdb;
+		try
+		{
+			if (options.pdb_file.empty())
+				pdb.emplace();
+			else
+				pdb.emplace(pattern_database<N>::open(options.pdb_file));
+		}
+		catch (std::runtime_error const& e)
+		{
+			std::cerr << e.what() << endl;
+			return false;
+		}
+		auto const build_time = std::chrono::steady_clock::now() - build_start;
+
+		cout << "Pattern database: " << pdb->partition().size() << " patterns, " << pdb->size_bytes() << " bytes, "
+			<< (options.pdb_file.empty() ? "built" : "opened") << " in " << ms_t(build_time).count() << " ms" << endl;
+
+		success = solve_with(std::cref(*pdb));
+		break;
+	}
+	case HeuristicType::ZERO:
+		success = solve_with([](puzzle_t const&) { return size_t(0); });
+		break;
 	}
 	
 	if (!success)
@@ -173,6 +231,21 @@ bool solve_n_sq_puzzle(puzzle_options const& options)
 		}
 	}
 
+	if (options.print_stats)
+	{
+		using ms_t = std::chrono::duration<double, std::milli>;
+
+		cout << "Nodes expanded: " << stats.nodes_expanded << endl;
+		cout << "Nodes generated: " << stats.nodes_generated << endl;
+		cout << "Stale fringe entries: " << stats.stale_entries << endl;
+		cout << "Iterations: " << stats.iterations << endl;
+		cout << "Peak nodes: " << stats.peak_num_nodes << endl;
+		cout << "Peak fringe size: " << stats.peak_fringe_size << endl;
+		cout << "Peak memory: " << stats.peak_memory << " bytes" << endl;
+		cout << "Search time: " << ms_t(stats.search_time).count() << " ms" << endl;
+		cout << "Path time: " << ms_t(stats.path_time).count() << " ms" << endl;
+	}
+
 	return success;
 }
 
@@ -215,6 +288,10 @@ bool parse_cmd_line(int argc, char** argv, puzzle_options& options)
 		{
 			options.use_ida = true;
 		}
+		else if (strcmp(argv[arg], "--stats") == 0)
+		{
+			options.print_stats = true;
+		}
 		else if (strcmp(argv[arg], "--state") == 0)
 		{
 			if ((arg + 1) >= argc)
@@ -247,6 +324,12 @@ bool parse_cmd_line(int argc, char** argv, puzzle_options& options)
 				options.heuristic_type = HeuristicType::MISPLACED;
 			else if (strcmp(h_type_str.c_str(), "taxicab") == 0)
 				options.heuristic_type = HeuristicType::TAXICAB;
+			else if (strcmp(h_type_str.c_str(), "linear_conflict") == 0)
+				options.heuristic_type = HeuristicType::LINEAR_CONFLICT;
+			else if (strcmp(h_type_str.c_str(), "walking_distance") == 0)
+				options.heuristic_type = HeuristicType::WALKING_DISTANCE;
+			else if (strcmp(h_type_str.c_str(), "pdb") == 0)
+				options.heuristic_type = HeuristicType::PDB;
 			else if (strcmp(h_type_str.c_str(), "zero") == 0)
 				options.heuristic_type = HeuristicType::ZERO;
 			else
@@ -255,6 +338,16 @@ bool parse_cmd_line(int argc, char** argv, puzzle_options& options)
 				return false;
 			}
 		}
+		else if (strcmp(argv[arg], "--pdb_file") == 0)
+		{
+			if ((arg + 1) >= argc)
+			{
+				std::cerr << "Option requires argument: " << argv[arg] << endl;
+				return false;
+			}
+
+			options.pdb_file = argv[++arg];
+		}
 		else if (strcmp(argv[arg], "--seed") == 0)
 		{
 			try
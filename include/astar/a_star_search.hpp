@@ -15,18 +15,18 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <set>
-#include <list>
-#include <algorithm>
+#include <vector>
 #include <limits>
 #include <functional>
-#include <queue>
-#include <stack>
+#include <optional>
 #include <utility>
 
 #include <astar/detail/node.hpp>
+#include <astar/detail/a_star_search.hpp>
 #include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/path_summary.hpp>
+#include <astar/search_stats.hpp>
 
 namespace cds
 {
@@ -35,15 +35,20 @@ namespace astar
 {
 
 /// Implicit graph A* search
+/// @tparam Policy search_policy<> that selects the fringe and node storage
+///			implementations, and whether CLOSED nodes can be reopened
+/// @param observer Receives the search's statistics, e.g. search_stats_observer
 /// @return The shortest path from the start node to the goal node
 ///			if one exists, otherwise, return an empty list.
-template <	typename NodeType,
+template <	typename Policy = default_search_policy,
+				typename NodeType,
 				typename ExpandFn, 
 				typename CostFn,
 				typename WeightFn,
 				typename IsGoalFn,
 				typename OutputIterator,
-				typename HashFn = std::hash<NodeType> >
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
 bool a_star_search(
 	NodeType	start_node,
 	ExpandFn	expand_fn,
@@ -52,97 +57,68 @@ bool a_star_search(
 	IsGoalFn is_goal,
 	OutputIterator out_it,
 	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
-	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max())
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	Observer observer = Observer())
 {
-	using cost_fn_t = 				cost_value_t<CostFn, NodeType>;
-	using node_goal_cost_est_t =	detail_::node_goal_cost_estimate<NodeType, CostFn>;
-	using node_info_t = 				detail_::node_info<NodeType, CostFn>;
-	using node_collection_t =		std::unordered_map<NodeType, node_info_t, HashFn>;
-	using detail_::NodeSetType;
-																
-	std::priority_queue<node_goal_cost_est_t> fringe;
+	using node_info_t =			detail_::node_info<NodeType, CostFn>;
+	using node_collection_t =	typename Policy::node_storage::template type<NodeType, node_info_t, HashFn>;
+	using fringe_t =				typename Policy::fringe::template type<NodeType, CostFn>;
+
+	node_collection_t nodes;
+	fringe_t fringe;
+
+	auto const goal_entry = detail_::a_star_search_impl<Policy>(
+		nodes, fringe,
+		start_node, expand_fn, cost_to_goal_fn, neighbor_weight_fn, is_goal,
+		opt_out_path_cost, max_cost, observer);
+
+	if (!goal_entry)
+		return false;
+
+	detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+
+	std::vector<typename node_info_t::entry_ptr_t> path;
+	detail_::output_path(goal_entry, path, out_it);
+
+	return true;
+}
+
+/// Same as a_star_search(), but only returns the length and cost of the
+/// shortest path, without copying the path's nodes.
+/// @return The path summary, or std::nullopt if no path was found
+template <	typename Policy = default_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+std::optional<path_summary<cost_value_t<CostFn, NodeType>>> a_star_path_summary(
+	NodeType	start_node,
+	ExpandFn	expand_fn,
+	CostFn	cost_to_goal_fn,
+	WeightFn	neighbor_weight_fn,
+	IsGoalFn is_goal,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	Observer observer = Observer())
+{
+	using node_info_t =			detail_::node_info<NodeType, CostFn>;
+	using node_collection_t =	typename Policy::node_storage::template type<NodeType, node_info_t, HashFn>;
+	using fringe_t =				typename Policy::fringe::template type<NodeType, CostFn>;
+
 	node_collection_t nodes;
-	{
-		typename node_collection_t::iterator start_node_it;
-		tie(start_node_it, std::ignore) = 
-			nodes.emplace(std::make_pair(start_node, node_info_t(NodeSetType::OPEN, 0.0)));
-			
-		fringe.emplace(node_goal_cost_est_t{&(*start_node_it), cost_to_goal_fn(start_node)});
-	}
-
-	std::list<NodeType> path;
-
-	while (!fringe.empty())
-	{
-		auto min_cost_node = fringe.top();
-		fringe.pop();
-
-		// Might as well always assign this, even if we don't find a path
-		if (opt_out_path_cost)
-			*opt_out_path_cost = min_cost_node.cost;
-
-		if (min_cost_node.cost > max_cost)
-			return false; // We won't find a better solution
-
-		NodeType const& n = min_cost_node.node_index->first;
-
-		if (is_goal(n))
-		{
-			NodeType next = n;
-			path.push_front(next);
-
-			// Reconstruct path and return
-			while (next != start_node)
-			{
-				auto n_it = nodes.find(next)->second;
-				auto prev_node_it = n_it.prev_node;
-
-				next = prev_node_it->first;
-
-				path.push_front(next);
-			}
-			
-			std::copy(path.begin(), path.end(), out_it);
-
-			return true;
-		}
-
-		auto n_it = nodes.find(n);
-		node_info_t& n_info = n_it->second;
-		n_info.type = NodeSetType::CLOSED;
-
-		auto neighbors = expand_fn(n);
-		for (auto adj_node : neighbors)
-		{
-			auto adj_node_it = nodes.find(adj_node);
-			if (adj_node_it != nodes.end() && adj_node_it->second.type == NodeSetType::CLOSED)
-			{
-				// Neighbor already evaluated
-				continue;
-			}
-
-			// Distance from the starting node to a neighbor
-			cost_fn_t const tentative_g_score = n_info.cost_to_node + neighbor_weight_fn(n, adj_node);
-			cost_fn_t const f_score = tentative_g_score + cost_to_goal_fn(adj_node);
-
-			if (adj_node_it == nodes.end())
-			{
-				// discover a new node
-				tie(adj_node_it, std::ignore) = 
-					nodes.emplace(std::make_pair(adj_node, node_info_t(NodeSetType::OPEN, tentative_g_score)));
-			}
-			else if (tentative_g_score >= adj_node_it->second.cost_to_node)
-				continue;	// Sub-optimal path
-
-			adj_node_it->second.prev_node = &(*n_it);
-			adj_node_it->second.cost_to_node = tentative_g_score;
-
-			fringe.emplace(node_goal_cost_est_t{&(*adj_node_it), f_score});
-		}
-	}
-
-	// No path exists
-	return false;
+	fringe_t fringe;
+
+	auto const goal_entry = detail_::a_star_search_impl<Policy>(
+		nodes, fringe,
+		start_node, expand_fn, cost_to_goal_fn, neighbor_weight_fn, is_goal,
+		nullptr, max_cost, observer);
+
+	if (!goal_entry)
+		return std::nullopt;
+
+	return path_summary<cost_value_t<CostFn, NodeType>>{ detail_::path_length(goal_entry), goal_entry->second.cost_to_node };
 }
 
 } // namespace astar
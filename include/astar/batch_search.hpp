@@ -0,0 +1,163 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Batches of independent start/goal queries, searched in parallel
+
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <functional>
+#include <optional>
+#include <atomic>
+#include <memory>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include <astar/detail/thread_pool.hpp>
+#include <astar/search_context.hpp>
+#include <astar/search_policy.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+/// A path found by a batch search, and its cost
+template <typename NodeType, typename Cost>
+struct search_result
+{
+	std::vector<NodeType> path;
+	Cost cost;
+};
+
+namespace detail_
+{
+
+/// Binds a heuristic that takes (node, goal) to one query's goal node
+template <typename NodeType, typename HeuristicFn>
+struct goal_heuristic
+{
+	HeuristicFn const* heuristic_fn;
+	NodeType const* goal;
+
+	auto operator()(NodeType const& n) const { return (*heuristic_fn)(n, *goal); }
+};
+
+} // namespace detail_
+
+/// Runs batches of (start, goal) queries on a pool of threads,
+/// each of which reuses its own search_context for its queries.
+/// The threads and their contexts are kept between batches.
+/// @tparam HeuristicFn Estimated cost from a node to a goal node, cost_to_goal_fn(node, goal)
+template <	typename NodeType,
+				typename HeuristicFn,
+				typename HashFn = std::hash<NodeType>,
+				typename Policy = context_search_policy >
+class batch_searcher
+{
+	using cost_fn_t = detail_::goal_heuristic<NodeType, HeuristicFn>;
+	using context_t = search_context<NodeType, cost_fn_t, HashFn, Policy>;
+
+public:
+	using cost_t = typename context_t::cost_t;
+	using result_t = std::optional<search_result<NodeType, cost_t>>;
+
+private:
+	detail_::thread_pool m_pool;
+	std::vector<std::unique_ptr<context_t>> m_contexts;	// one per thread
+
+public:
+	/// @param num_threads 0 uses std::thread::hardware_concurrency()
+	explicit batch_searcher(unsigned int num_threads = 0)
+		: m_pool(num_threads)
+	{
+		for (size_t i = 0 ; i < m_pool.size() ; i++)
+			m_contexts.push_back(std::make_unique<context_t>());
+	}
+
+	size_t num_threads() const { return m_pool.size(); }
+
+	/// A* searches from each query's start node to its goal node. expand_fn, cost_to_goal_fn
+	/// and neighbor_weight_fn are called concurrently, so they have to be thread safe.
+	/// @param begin, end Queries, (start, goal) pairs
+	/// @return Each query's shortest path, (or std::nullopt if there isn't one) in the same order as the queries
+	template <typename InputIterator, typename ExpandFn, typename WeightFn>
+	std::vector<result_t> search(
+		InputIterator begin,
+		InputIterator end,
+		ExpandFn expand_fn,
+		HeuristicFn cost_to_goal_fn,
+		WeightFn neighbor_weight_fn,
+		cost_t max_cost = std::numeric_limits<cost_t>::max())
+	{
+		using query_t = typename std::iterator_traits<InputIterator>::value_type;
+
+		std::vector<query_t> const queries(begin, end);
+		std::vector<result_t> results(queries.size());
+
+		// Queries can take very different amounts of time, so the
+		// threads take the next one as soon as they're done
+		std::atomic<size_t> next_query{0};
+
+		m_pool.run([&](size_t worker_index)
+		{
+			context_t& context = *m_contexts[worker_index];
+
+			for (size_t i = next_query++ ; i < queries.size() ; i = next_query++)
+			{
+				NodeType const& start = std::get<0>(queries[i]);
+				NodeType const& goal = std::get<1>(queries[i]);
+
+				search_result<NodeType, cost_t> result;
+				if (context.search(
+						start, expand_fn, cost_fn_t{&cost_to_goal_fn, &goal}, neighbor_weight_fn,
+						[&goal](NodeType const& n) { return n == goal; },
+						std::back_inserter(result.path), &result.cost, max_cost))
+				{
+					results[i] = std::move(result);
+				}
+			}
+		});
+
+		return results;
+	}
+};
+
+/// Searches a batch of (start, goal) queries in parallel, see batch_searcher.
+/// Use a batch_searcher directly to keep the threads and their storage for the next batch.
+/// @param num_threads 0 uses std::thread::hardware_concurrency()
+/// @return Each query's shortest path, (or std::nullopt if there isn't one) in the same order as the queries
+template <	typename Policy = context_search_policy,
+				typename InputIterator,
+				typename ExpandFn,
+				typename HeuristicFn,
+				typename WeightFn,
+				typename NodeType = std::decay_t<std::tuple_element_t<0, typename std::iterator_traits<InputIterator>::value_type>>,
+				typename HashFn = std::hash<NodeType> >
+auto batch_search(
+	InputIterator begin,
+	InputIterator end,
+	ExpandFn expand_fn,
+	HeuristicFn cost_to_goal_fn,
+	WeightFn neighbor_weight_fn,
+	unsigned int num_threads = 0)
+{
+	batch_searcher<NodeType, HeuristicFn, HashFn, Policy> searcher(num_threads);
+	return searcher.search(begin, end, expand_fn, cost_to_goal_fn, neighbor_weight_fn);
+}
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,301 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Implicit graph bidirectional A* search.
+// Searches forward from the start node and backward from the goal node
+// using the average of the two heuristics, ((h_f - h_b) / 2 forward, and
+// (h_b - h_f) / 2 backward) which keeps both searches consistent with each
+// other. A node's key is then a lower bound on the length of any path
+// through it, so the search can stop as soon as the two fringes' lowest
+// keys add up to the cost of the best path found where the searches met.
+
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <type_traits>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/a_star_search.hpp>
+#include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/search_stats.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// One direction of a bidirectional search: its nodes, fringe, and
+/// the lowest cost fringe entry (popped from the fringe, but not yet expanded).
+/// Fringe entries' costs are twice the node's key, 2g + h - h_other, so they
+/// don't need to be halved (and stay non-negative, since h_other is admissible).
+template <typename Policy, typename NodeType, typename CostFn, typename HashFn>
+struct bidirectional_frontier
+{
+	using node_info_t =			node_info<NodeType, CostFn>;
+	using entry_ptr_t =			typename node_info_t::entry_ptr_t;
+	using node_collection_t =	typename Policy::node_storage::template type<NodeType, node_info_t, HashFn>;
+	using fringe_t =				typename Policy::fringe::template type<NodeType, CostFn>;
+	using value_type =			typename fringe_t::value_type;
+	using cost_t =					cost_value_t<CostFn, NodeType>;
+
+	node_collection_t nodes;
+	fringe_t fringe;
+	std::optional<value_type> top;
+
+	/// Pops stale entries, so that top is the lowest cost entry of an OPEN node
+	/// @return false if there are no more nodes to expand
+	template <typename Observer>
+	bool update_top(Observer& observer)
+	{
+		while (!top.has_value() && !fringe.empty())
+		{
+			value_type const v = fringe.pop();
+			node_info_t const& n_info = v.node_index->second;
+
+			if (n_info.type == NodeSetType::CLOSED || v.cost_to_node > n_info.cost_to_node)
+				observer.stale_entry_skipped();
+			else
+				top = v;
+		}
+
+		return top.has_value();
+	}
+
+	/// Adds (or updates) a node, with cost_to_node g, and twice its key
+	void push(entry_ptr_t e, cost_t g, cost_t doubled_key)
+	{
+		e->second.type = NodeSetType::OPEN;
+		e->second.cost_to_node = g;
+		fringe.push(value_type{e, doubled_key, g});
+	}
+
+	size_t size() const { return fringe.size() + (top.has_value() ? 1 : 0); }
+};
+
+/// Expands the top node of one direction.
+/// weight(n, adj) is the weight of the edge from n to adj in the direction being searched,
+/// and on_meet(adj_entry, other_entry) is called when a node that the other direction has
+/// reached is generated.
+template <	typename Policy,
+				typename Frontier,
+				typename OtherFrontier,
+				typename ExpandFn,
+				typename KeyFn,
+				typename WeightFn,
+				typename MeetFn,
+				typename Observer >
+void bidirectional_step(
+	Frontier& frontier,
+	OtherFrontier& other,
+	ExpandFn& expand_fn,
+	KeyFn doubled_key,
+	WeightFn weight,
+	MeetFn on_meet,
+	Observer& observer)
+{
+	using node_info_t = typename Frontier::node_info_t;
+	using cost_t = typename Frontier::cost_t;
+
+	auto const n_it = frontier.top->node_index;
+	frontier.top.reset();
+
+	node_info_t& n_info = n_it->second;
+	n_info.type = NodeSetType::CLOSED;
+	observer.node_expanded();
+
+	auto const& n = n_it->first;
+
+	auto neighbors = expand_fn(n);
+	for (auto adj_node : neighbors)
+	{
+		auto adj_node_it = frontier.nodes.find(adj_node);
+		if (Policy::reopen == ReopenPolicy::NEVER &&
+			 adj_node_it && adj_node_it->second.type == NodeSetType::CLOSED)
+		{
+			continue;
+		}
+
+		cost_t const tentative_g_score = n_info.cost_to_node + weight(n, adj_node);
+
+		if (!adj_node_it)
+			std::tie(adj_node_it, std::ignore) = frontier.nodes.emplace(adj_node, node_info_t(NodeSetType::OPEN, tentative_g_score));
+		else if (tentative_g_score >= adj_node_it->second.cost_to_node)
+			continue;	// Sub-optimal path
+		else if (adj_node_it->second.type == NodeSetType::CLOSED)
+			observer.node_reopened();
+
+		observer.node_generated();
+
+		adj_node_it->second.prev_node = n_it;
+		frontier.push(adj_node_it, tentative_g_score, doubled_key(adj_node, tentative_g_score));
+
+		if (auto other_it = other.nodes.find(adj_node))
+			on_meet(adj_node_it, other_it);
+	}
+}
+
+} // namespace detail_
+
+/// Implicit graph bidirectional A* search.
+/// Both heuristics must be consistent (monotone), e.g. straight line distances.
+/// @tparam Policy search_policy<> that selects the fringe and node storage
+///			implementations (for both directions), and whether CLOSED nodes can be reopened
+/// @param reverse_expand_fn Returns the predecessors of a node
+/// @param cost_to_start_fn Heuristic estimate of the cost from the start node to a node
+/// @param neighbor_weight_fn Weight of the edge from the first node to the second
+/// @param observer Receives the search's statistics, e.g. search_stats_observer
+/// @return Whether a path was found. The path (from the start node to the goal node)
+///			is written to out_it, and its cost to opt_out_path_cost.
+template <	typename Policy = default_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename ReverseExpandFn,
+				typename CostFn,
+				typename ReverseCostFn,
+				typename WeightFn,
+				typename OutputIterator,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+bool bidirectional_a_star_search(
+	NodeType	start_node,
+	NodeType goal_node,
+	ExpandFn	expand_fn,
+	ReverseExpandFn reverse_expand_fn,
+	CostFn	cost_to_goal_fn,
+	ReverseCostFn cost_to_start_fn,
+	WeightFn	neighbor_weight_fn,
+	OutputIterator out_it,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	Observer observer = Observer())
+{
+	using cost_t = cost_value_t<CostFn, NodeType>;
+
+	static_assert(std::is_same_v<cost_t, cost_value_t<ReverseCostFn, NodeType>>,
+		"Forward and reverse heuristics must have the same cost type");
+
+	using fwd_frontier_t = detail_::bidirectional_frontier<Policy, NodeType, CostFn, HashFn>;
+	using bwd_frontier_t = detail_::bidirectional_frontier<Policy, NodeType, ReverseCostFn, HashFn>;
+	using fwd_entry_ptr_t = typename fwd_frontier_t::entry_ptr_t;
+	using bwd_entry_ptr_t = typename bwd_frontier_t::entry_ptr_t;
+
+	fwd_frontier_t fwd;
+	bwd_frontier_t bwd;
+
+	// Cheapest path found so far, and where the two searches met on it
+	cost_t best_cost = std::numeric_limits<cost_t>::max();
+	fwd_entry_ptr_t meet_fwd = nullptr;
+	bwd_entry_ptr_t meet_bwd = nullptr;
+
+	auto meet = [&best_cost, &meet_fwd, &meet_bwd](fwd_entry_ptr_t f, bwd_entry_ptr_t b)
+	{
+		cost_t const cost = f->second.cost_to_node + b->second.cost_to_node;
+		if (cost < best_cost)
+		{
+			best_cost = cost;
+			meet_fwd = f;
+			meet_bwd = b;
+		}
+	};
+
+	// Twice the nodes' keys, (2g + h_f - h_b forward, 2g + h_b - h_f backward)
+	auto fwd_key = [&cost_to_goal_fn, &cost_to_start_fn](NodeType const& n, cost_t g)
+	{
+		return (g + g + cost_to_goal_fn(n)) - cost_to_start_fn(n);
+	};
+
+	auto bwd_key = [&cost_to_goal_fn, &cost_to_start_fn](NodeType const& n, cost_t g)
+	{
+		return (g + g + cost_to_start_fn(n)) - cost_to_goal_fn(n);
+	};
+
+	{
+		detail_::scoped_phase<Observer> phase(observer, SearchPhase::SEARCH);
+		observer.iteration_started();
+
+		fwd_entry_ptr_t start_it;
+		std::tie(start_it, std::ignore) = fwd.nodes.emplace(start_node, typename fwd_frontier_t::node_info_t(detail_::NodeSetType::OPEN, 0));
+		fwd.push(start_it, 0, fwd_key(start_node, 0));
+
+		bwd_entry_ptr_t goal_it;
+		std::tie(goal_it, std::ignore) = bwd.nodes.emplace(goal_node, typename bwd_frontier_t::node_info_t(detail_::NodeSetType::OPEN, 0));
+		bwd.push(goal_it, 0, bwd_key(goal_node, 0));
+
+		if (auto b = bwd.nodes.find(start_node))
+			meet(start_it, b);
+
+		while (fwd.update_top(observer) && bwd.update_top(observer))
+		{
+			// The keys of the two top nodes add up to a lower bound
+			// on the cost of any path that hasn't been found yet
+			cost_t const lower_bound_x2 = fwd.top->cost + bwd.top->cost;
+			if (best_cost != std::numeric_limits<cost_t>::max() && lower_bound_x2 >= best_cost + best_cost)
+				break;
+
+			if (max_cost < std::numeric_limits<cost_t>::max() / 2 && lower_bound_x2 > max_cost + max_cost)
+				break;	// Only paths that are too expensive are left
+
+			// Expand the smaller frontier
+			if (fwd.size() <= bwd.size())
+			{
+				detail_::bidirectional_step<Policy>(
+					fwd, bwd, expand_fn, fwd_key,
+					[&neighbor_weight_fn](NodeType const& n, NodeType const& adj) { return neighbor_weight_fn(n, adj); },
+					meet, observer);
+			}
+			else
+			{
+				detail_::bidirectional_step<Policy>(
+					bwd, fwd, reverse_expand_fn, bwd_key,
+					[&neighbor_weight_fn](NodeType const& n, NodeType const& adj) { return neighbor_weight_fn(adj, n); },
+					[&meet](bwd_entry_ptr_t b, fwd_entry_ptr_t f) { meet(f, b); },
+					observer);
+			}
+
+			observer.memory_used(fwd.nodes.size() + bwd.nodes.size(), fwd.size() + bwd.size(),
+				fwd.nodes.size() * sizeof(std::remove_pointer_t<fwd_entry_ptr_t>) +
+				bwd.nodes.size() * sizeof(std::remove_pointer_t<bwd_entry_ptr_t>) +
+				fwd.size() * sizeof(typename fwd_frontier_t::value_type) +
+				bwd.size() * sizeof(typename bwd_frontier_t::value_type));
+		}
+	}
+
+	if (!meet_fwd || best_cost > max_cost)
+		return false;
+
+	if (opt_out_path_cost)
+		*opt_out_path_cost = best_cost;
+
+	detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+
+	// Start node to meeting node, then on to the goal node
+	std::vector<fwd_entry_ptr_t> path;
+	detail_::output_path(meet_fwd, path, out_it);
+
+	for (bwd_entry_ptr_t e = meet_bwd->second.prev_node ; e ; e = e->second.prev_node)
+		*out_it++ = e->first;
+
+	return true;
+}
+
+} // namespace astar
+
+} // namespace cds
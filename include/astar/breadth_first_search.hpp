@@ -0,0 +1,172 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Exhaustive breadth first search of state spaces with a perfect hash,
+// e.g. to find the exact distance of every 8-puzzle state from the goal.
+// Each state is kept in 2 bits, indexed by the state's rank, as unvisited,
+// in one of the two layers being searched, or closed once it's expanded.
+// Each layer is expanded in parallel.
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+#include <astar/detail/thread_pool.hpp>
+#include <astar/detail/two_bit_array.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+/// Finds every state that can be reached from start, layer by layer.
+/// rank maps each state to a distinct index below num_states, and unrank is
+/// its inverse. Apart from the 2 bits for each index, nothing is stored, so
+/// each layer is found by scanning all of the states for the previous one.
+/// expand, rank, unrank and visit are called from all of the threads at once.
+/// @param visit Called as visit(rank, depth) once for each state that's found,
+///			(including start, at depth 0) as soon as it's found
+/// @param num_threads Number of threads, including the calling thread.
+///			0 uses std::thread::hardware_concurrency()
+/// @return The number of states at each depth
+template <	typename NodeType,
+				typename ExpandFn,
+				typename RankFn,
+				typename UnrankFn,
+				typename VisitFn >
+std::vector<size_t> breadth_first_layers(
+	NodeType const& start,
+	size_t num_states,
+	ExpandFn expand,
+	RankFn rank,
+	UnrankFn unrank,
+	VisitFn visit,
+	unsigned int num_threads = 0)
+{
+	using words_t = detail_::two_bit_array;
+
+	constexpr unsigned int closed = 0;
+	constexpr unsigned int unvisited = 3;
+	constexpr size_t words_per_chunk = 256;
+
+	// The layers alternate between 1 and 2
+	auto layer_value = [](size_t depth) { return static_cast<unsigned int>(1 + depth % 2); };
+
+	words_t layers(num_states, unvisited);
+
+	size_t const start_rank = rank(start);
+	layers.compare_exchange(start_rank, unvisited, layer_value(0));
+	visit(start_rank, size_t(0));
+
+	detail_::thread_pool pool(num_threads);
+	size_t const num_chunks = (layers.num_words() + words_per_chunk - 1) / words_per_chunk;
+
+	std::vector<size_t> layer_sizes{ 1 };
+	for (size_t depth = 0 ; layer_sizes.back() != 0 ; depth++)
+	{
+		unsigned int const layer = layer_value(depth);
+		unsigned int const next_layer = layer_value(depth + 1);
+
+		std::atomic<size_t> next_chunk{ 0 };
+		std::atomic<size_t> next_layer_size{ 0 };
+
+		pool.run([&](size_t)
+			{
+				size_t found = 0;
+				for (size_t chunk ; (chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) < num_chunks ; )
+				{
+					size_t const end_word = std::min((chunk + 1) * words_per_chunk, layers.num_words());
+					for (size_t w = chunk * words_per_chunk ; w < end_word ; w++)
+					{
+						// States found in this pass are in next_layer, so they don't match
+						uint64_t const expanded = words_t::matches(layers.word(w), layer);
+						if (expanded == 0)
+							continue;
+
+						for (uint64_t m = expanded ; m != 0 ; m &= m - 1)
+						{
+							size_t bit = 0;
+							while (!((m >> bit) & 1))
+								bit++;
+
+							NodeType const node = unrank(w * words_t::values_per_word + bit / 2);
+							for (auto&& adj_node : expand(node))
+							{
+								size_t const adj_rank = rank(adj_node);
+								if (layers.compare_exchange(adj_rank, unvisited, next_layer))
+								{
+									visit(adj_rank, depth + 1);
+									found++;
+								}
+							}
+						}
+
+						layers.reset(w, expanded, closed);
+					}
+				}
+
+				next_layer_size.fetch_add(found, std::memory_order_relaxed);
+			});
+
+		layer_sizes.push_back(next_layer_size.load());
+	}
+
+	layer_sizes.pop_back();
+	return layer_sizes;
+}
+
+/// Distance table entry for the states that can't be reached
+constexpr uint8_t unreachable_distance = std::numeric_limits<uint8_t>::max();
+
+/// Distance from start to every state, by rank, (see breadth_first_layers())
+/// or unreachable_distance for the states that can't be reached
+/// @throws std::overflow_error if a state is too far away to fit in the table
+template <	typename NodeType,
+				typename ExpandFn,
+				typename RankFn,
+				typename UnrankFn >
+std::vector<uint8_t> breadth_first_distance_table(
+	NodeType const& start,
+	size_t num_states,
+	ExpandFn expand,
+	RankFn rank,
+	UnrankFn unrank,
+	unsigned int num_threads = 0)
+{
+	std::vector<uint8_t> distances(num_states, unreachable_distance);
+	std::atomic<bool> overflow{ false };
+
+	breadth_first_layers(start, num_states, expand, rank, unrank,
+		[&distances, &overflow](size_t r, size_t depth)
+		{
+			if (depth >= unreachable_distance)
+				overflow.store(true, std::memory_order_relaxed);
+
+			distances[r] = static_cast<uint8_t>(depth);
+		},
+		num_threads);
+
+	if (overflow)
+		throw std::overflow_error("Distances don't fit in the distance table");
+
+	return distances;
+}
+
+} // namespace astar
+
+} // namespace cds
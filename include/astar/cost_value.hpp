@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <utility>
 
 namespace cds
@@ -20,5 +21,29 @@ namespace cds
 	{
 		template <typename CostFn, typename NodeType>
 		using cost_value_t = decltype(std::declval<CostFn>()(std::declval<NodeType>()));
+
+		/// Whether cost_to_goal_fn can also be called as cost_to_goal_fn(parent, parent_cost_to_goal, node),
+		/// to estimate the cost to goal of a successor of parent from parent's estimate.
+		/// The searches use this overload for every node but the start node.
+		template <typename CostFn, typename NodeType>
+		constexpr bool is_incremental_cost_fn_v = std::is_invocable_v<
+			CostFn&, NodeType const&, cost_value_t<CostFn, NodeType>, NodeType const&>;
+
+		namespace detail_
+		{
+			/// Estimated cost to goal of node, a successor of parent
+			template <typename CostFn, typename NodeType>
+			cost_value_t<CostFn, NodeType> successor_cost_to_goal(
+				CostFn& cost_to_goal_fn,
+				NodeType const& parent,
+				cost_value_t<CostFn, NodeType> parent_cost_to_goal,
+				NodeType const& node)
+			{
+				if constexpr (is_incremental_cost_fn_v<CostFn, NodeType>)
+					return cost_to_goal_fn(parent, parent_cost_to_goal, node);
+				else
+					return cost_to_goal_fn(node);
+			}
+		}
 	}
-}
\ No newline at end of file
+}
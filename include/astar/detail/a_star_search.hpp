@@ -0,0 +1,185 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include <astar/detail/node.hpp>
+#include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/search_stats.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Writes the path that ends at goal_entry, from the start node to the goal, to out_it.
+/// Follows the prev_node links into the (reusable) path buffer, so each node is copied once.
+template <typename EntryPtr, typename OutputIterator>
+void output_path(EntryPtr goal_entry, std::vector<EntryPtr>& path, OutputIterator out_it)
+{
+	path.clear();
+	for (EntryPtr e = goal_entry ; e ; e = e->second.prev_node)
+		path.push_back(e);
+
+	for (auto p_it = path.rbegin() ; p_it != path.rend() ; ++p_it)
+		*out_it++ = (*p_it)->first;
+}
+
+/// Number of nodes in the path that ends at goal_entry, including the start and goal nodes
+template <typename EntryPtr>
+size_t path_length(EntryPtr goal_entry)
+{
+	size_t length = 0;
+	for (EntryPtr e = goal_entry ; e ; e = e->second.prev_node)
+		length++;
+
+	return length;
+}
+
+/// A* search loop, using the given (possibly reused) node storage and fringe.
+/// These are cleared first, but keep their storage.
+/// Reports the search's progress to observer.
+/// @return The goal node's entry, or nullptr if no path was found
+template <	typename Policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename NodeCollection,
+				typename Fringe,
+				typename Observer >
+typename node_info<NodeType, CostFn>::entry_ptr_t a_star_search_impl(
+	NodeCollection& nodes,
+	Fringe& fringe,
+	NodeType const& start_node,
+	ExpandFn& expand_fn,
+	CostFn& cost_to_goal_fn,
+	WeightFn& neighbor_weight_fn,
+	IsGoalFn& is_goal,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost,
+	cost_value_t<CostFn, NodeType> max_cost,
+	Observer& observer)
+{
+	using cost_fn_t = 				cost_value_t<CostFn, NodeType>;
+	using node_goal_cost_est_t =	node_goal_cost_estimate<NodeType, CostFn>;
+	using node_info_t = 				node_info<NodeType, CostFn>;
+
+	scoped_phase<Observer> phase(observer, SearchPhase::SEARCH);
+	observer.iteration_started();
+
+	auto report_memory = [&nodes, &fringe, &observer]
+	{
+		observer.memory_used(nodes.size(), fringe.size(),
+			nodes.size() * sizeof(std::remove_pointer_t<typename node_info_t::entry_ptr_t>) + fringe.size() * sizeof(node_goal_cost_est_t));
+	};
+
+	nodes.clear();
+	fringe.clear();
+
+	{
+		typename node_info_t::entry_ptr_t start_node_it;
+		tie(start_node_it, std::ignore) = nodes.emplace(start_node, node_info_t(NodeSetType::OPEN, 0));
+			
+		fringe.push(node_goal_cost_est_t{start_node_it, cost_to_goal_fn(start_node), 0});
+	}
+
+	report_memory();
+
+	while (!fringe.empty())
+	{
+		auto min_cost_node = fringe.pop();
+		node_info_t& n_info = min_cost_node.node_index->second;
+
+		// Skip stale fringe entries: the node has already been expanded,
+		// or a cheaper path to it was found after this entry was pushed
+		if (n_info.type == NodeSetType::CLOSED || min_cost_node.cost_to_node > n_info.cost_to_node)
+		{
+			observer.stale_entry_skipped();
+			continue;
+		}
+
+		// Might as well always assign this, even if we don't find a path
+		if (opt_out_path_cost)
+			*opt_out_path_cost = min_cost_node.cost;
+
+		if (min_cost_node.cost > max_cost)
+			return nullptr; // We won't find a better solution
+
+		NodeType const& n = min_cost_node.node_index->first;
+
+		if (is_goal(n))
+			return min_cost_node.node_index;
+
+		n_info.type = NodeSetType::CLOSED;
+		observer.node_expanded();
+
+		// For incremental cost to goal functions
+		cost_fn_t const n_cost_to_goal = min_cost_node.cost - min_cost_node.cost_to_node;
+
+		auto neighbors = expand_fn(n);
+		for (auto adj_node : neighbors)
+		{
+			auto adj_node_it = nodes.find(adj_node);
+			if (Policy::reopen == ReopenPolicy::NEVER &&
+				 adj_node_it && adj_node_it->second.type == NodeSetType::CLOSED)
+			{
+				// Neighbor already evaluated
+				continue;
+			}
+
+			// Distance from the starting node to a neighbor
+			cost_fn_t const tentative_g_score = n_info.cost_to_node + neighbor_weight_fn(n, adj_node);
+			cost_fn_t const f_score = tentative_g_score + successor_cost_to_goal(cost_to_goal_fn, n, n_cost_to_goal, adj_node);
+
+			if (!adj_node_it)
+			{
+				// discover a new node
+				tie(adj_node_it, std::ignore) = nodes.emplace(adj_node, node_info_t(NodeSetType::OPEN, tentative_g_score));
+			}
+			else if (tentative_g_score >= adj_node_it->second.cost_to_node)
+				continue;	// Sub-optimal path
+			else if (adj_node_it->second.type == NodeSetType::CLOSED)
+				observer.node_reopened();
+
+			observer.node_generated();
+
+			adj_node_it->second.type = NodeSetType::OPEN;	// reopens the node if it was CLOSED
+			adj_node_it->second.prev_node = min_cost_node.node_index;
+			adj_node_it->second.cost_to_node = tentative_g_score;
+
+			fringe.push(node_goal_cost_est_t{adj_node_it, f_score, tentative_g_score});
+		}
+
+		report_memory();
+	}
+
+	// No path exists
+	return nullptr;
+}
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,163 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Node storage indexed by a perfect hash of the nodes
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/node_arena.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Node storage for state spaces with a perfect hash: IndexFn maps each node to
+/// a distinct index below IndexFn().size(), (e.g. the rank of a permutation)
+/// and a flat array holds a pointer to each node's entry, at the node's index.
+/// Finding a node is one indexed read, with no hashing or probing. The entries
+/// themselves are allocated from a node_arena in the order they're added, like
+/// flat_node_map's, so nodes that are found around the same time (and expanded
+/// around the same time) are close together.
+/// Same interface as the other node maps (see node_map.hpp).
+template <typename NodeType, typename InfoType, typename IndexFn>
+class dense_node_map
+{
+	using value_type = std::pair<const NodeType, InfoType>;
+
+public:
+	using entry_ptr_t = node_map_entry_ptr_t<NodeType, InfoType>;
+
+private:
+	IndexFn m_index_fn;
+	std::vector<entry_ptr_t> m_entries;	// by index, nullptr if there's no entry
+	std::vector<size_t> m_used;			// indices that have had entries since clear()
+	std::vector<bool> m_is_used;		// whether each index is in m_used
+	size_t m_size = 0;
+
+	node_arena m_arena;
+	std::vector<entry_ptr_t> m_free_entries;	// erased entries, for reuse
+
+	entry_ptr_t new_entry_(NodeType const& n, InfoType const& info)
+	{
+		void* p = nullptr;
+		if (!m_free_entries.empty())
+		{
+			p = m_free_entries.back();
+			m_free_entries.pop_back();
+		}
+		else
+		{
+			p = m_arena.allocate(sizeof(value_type), alignof(value_type));
+		}
+
+		return new (p) value_type(n, info);
+	}
+
+public:
+	dense_node_map()
+		: m_entries(m_index_fn.size(), nullptr)
+		, m_is_used(m_entries.size(), false)
+	{
+
+	}
+
+	dense_node_map(dense_node_map const&) = delete;
+	dense_node_map& operator=(dense_node_map const&) = delete;
+
+	~dense_node_map()
+	{
+		clear();
+	}
+
+	entry_ptr_t find(NodeType const& n)
+	{
+		return m_entries[m_index_fn(n)];
+	}
+
+	std::pair<entry_ptr_t, bool> emplace(NodeType const& n, InfoType const& info)
+	{
+		entry_ptr_t& e = m_entries[m_index_fn(n)];
+		if (e)
+			return std::make_pair(e, false);
+
+		e = new_entry_(n, info);
+		m_size++;
+
+		// Once per index, so nodes that are added and erased over and over
+		// (e.g. on an IDA* path) don't grow m_used
+		size_t const index = &e - m_entries.data();
+		if (!m_is_used[index])
+		{
+			m_is_used[index] = true;
+			m_used.push_back(index);
+		}
+
+		return std::make_pair(e, true);
+	}
+
+	void erase(entry_ptr_t e)
+	{
+		m_entries[m_index_fn(e->first)] = nullptr;
+
+		e->~value_type();
+		m_free_entries.push_back(e);
+		m_size--;
+	}
+
+	size_t size() const { return m_size; }
+
+	/// Number of nodes that can be stored, IndexFn().size()
+	size_t capacity() const { return m_entries.size(); }
+
+	/// Removes all the entries, but keeps the array and the arena blocks.
+	/// Only visits the indices that were used, so it's cheap after a small search.
+	void clear()
+	{
+		for (size_t i : m_used)
+		{
+			entry_ptr_t& e = m_entries[i];
+			if (e)
+				e->~value_type();
+
+			e = nullptr;
+			m_is_used[i] = false;
+		}
+
+		m_used.clear();
+		m_size = 0;
+		m_free_entries.clear();
+		m_arena.reset();
+	}
+
+	/// Number of indices that have had entries since clear()
+	size_t num_used() const { return m_used.size(); }
+
+	node_arena const& arena() const { return m_arena; }
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,248 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Open addressing (Robin Hood) node storage
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/node_arena.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Robin Hood hash table of node entries, with linear probing and
+/// backward shift deletion. The table itself is a flat array of
+/// (entry pointer, hash, probe distance) slots, the entries live in
+/// a node_arena so they never move, even when the table grows.
+/// Same interface as the other node maps (see node_map.hpp).
+template <typename NodeType, typename InfoType, typename HashFn>
+class flat_node_map
+{
+	using value_type = std::pair<const NodeType, InfoType>;
+
+public:
+	using entry_ptr_t = node_map_entry_ptr_t<NodeType, InfoType>;
+
+private:
+	struct slot
+	{
+		entry_ptr_t entry;
+		uint32_t hash;	// mixed hash, its top bits pick the home slot, and comparing it
+						// before the nodes checks the bits that didn't
+		uint32_t dist;	// probe distance + 1, 0 if the slot is empty
+	};
+
+	std::vector<slot> m_slots;		// size is a power of 2
+	size_t m_size = 0;
+	unsigned m_shift = 32;			// 32 - log2(m_slots.size())
+
+	node_arena m_arena;
+	std::vector<entry_ptr_t> m_free_entries;	// erased entries, for reuse
+
+	HashFn m_hash_fn;
+
+	static constexpr unsigned initial_capacity_log2 = 6;
+	static constexpr size_t initial_capacity = size_t(1) << initial_capacity_log2;
+
+	uint64_t hash_(NodeType const& n) const
+	{
+		// Mix the bits, std::hash is often the identity function
+		uint64_t h = static_cast<uint64_t>(m_hash_fn(n)) * 0x9E3779B97F4A7C15ull;
+		return h ^ (h >> 32);
+	}
+
+	size_t mask_() const { return m_slots.size() - 1; }
+
+	size_t home_slot_(uint32_t h) const { return static_cast<size_t>(h) >> m_shift; }
+
+	void insert_slot_(slot s)
+	{
+		size_t i = home_slot_(s.hash);
+		while (true)
+		{
+			slot& cur = m_slots[i];
+			if (cur.dist == 0)
+			{
+				cur = s;
+				return;
+			}
+
+			// Take from the rich (entries closer to their home slot)
+			if (cur.dist < s.dist)
+				std::swap(cur, s);
+
+			i = (i + 1) & mask_();
+			s.dist++;
+		}
+	}
+
+	void grow_()
+	{
+		std::vector<slot> old_slots(m_slots.size() * 2, slot{ nullptr, 0, 0 });
+		old_slots.swap(m_slots);
+		m_shift--;
+
+		for (slot s : old_slots)
+		{
+			if (s.dist != 0)
+			{
+				s.dist = 1;
+				insert_slot_(s);
+			}
+		}
+	}
+
+	size_t find_slot_(NodeType const& n, uint32_t h) const
+	{
+		if (m_slots.empty())
+			return npos;
+
+		size_t i = home_slot_(h);
+		for (uint32_t dist = 1 ; ; dist++)
+		{
+			slot const& s = m_slots[i];
+			if (s.dist < dist)
+				return npos;	// empty, or we'd have displaced this entry
+
+			if (s.hash == h && s.entry->first == n)
+				return i;
+
+			i = (i + 1) & mask_();
+		}
+	}
+
+	entry_ptr_t new_entry_(NodeType const& n, InfoType const& info)
+	{
+		void* p = nullptr;
+		if (!m_free_entries.empty())
+		{
+			p = m_free_entries.back();
+			m_free_entries.pop_back();
+		}
+		else
+		{
+			p = m_arena.allocate(sizeof(value_type), alignof(value_type));
+		}
+
+		return new (p) value_type(n, info);
+	}
+
+public:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	flat_node_map() = default;
+
+	flat_node_map(flat_node_map const&) = delete;
+	flat_node_map& operator=(flat_node_map const&) = delete;
+
+	~flat_node_map()
+	{
+		for (slot const& s : m_slots)
+			if (s.dist != 0)
+				s.entry->~value_type();
+	}
+
+	entry_ptr_t find(NodeType const& n)
+	{
+		size_t const i = find_slot_(n, static_cast<uint32_t>(hash_(n)));
+		return i != npos ? m_slots[i].entry : nullptr;
+	}
+
+	std::pair<entry_ptr_t, bool> emplace(NodeType const& n, InfoType const& info)
+	{
+		uint32_t const h = static_cast<uint32_t>(hash_(n));
+
+		size_t const i = find_slot_(n, h);
+		if (i != npos)
+			return std::make_pair(m_slots[i].entry, false);
+
+		// Keep the load factor under 7/8
+		if (m_slots.empty())
+		{
+			m_slots.assign(initial_capacity, slot{ nullptr, 0, 0 });
+			m_shift = 32 - initial_capacity_log2;
+		}
+		else if ((m_size + 1) * 8 > m_slots.size() * 7)
+		{
+			grow_();
+		}
+
+		entry_ptr_t const e = new_entry_(n, info);
+		insert_slot_(slot{ e, h, 1 });
+		m_size++;
+
+		return std::make_pair(e, true);
+	}
+
+	void erase(entry_ptr_t e)
+	{
+		size_t i = find_slot_(e->first, static_cast<uint32_t>(hash_(e->first)));
+		if (i == npos)
+			return;
+
+		e->~value_type();
+		m_free_entries.push_back(e);
+		m_size--;
+
+		// Backward shift the following entries, until we hit an empty
+		// slot or an entry that's in its home slot
+		size_t next = (i + 1) & mask_();
+		while (m_slots[next].dist > 1)
+		{
+			m_slots[i] = m_slots[next];
+			m_slots[i].dist--;
+
+			i = next;
+			next = (next + 1) & mask_();
+		}
+
+		m_slots[i] = slot{ nullptr, 0, 0 };
+	}
+
+	size_t size() const { return m_size; }
+
+	/// Removes all the entries, but keeps the table and the arena blocks
+	void clear()
+	{
+		for (slot& s : m_slots)
+		{
+			if (s.dist != 0)
+				s.entry->~value_type();
+
+			s = slot{ nullptr, 0, 0 };
+		}
+
+		m_size = 0;
+		m_free_entries.clear();
+		m_arena.reset();
+	}
+
+	node_arena const& arena() const { return m_arena; }
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -14,10 +14,18 @@
 
 #include <astar/detail/node.hpp>
 #include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/search_stats.hpp>
 
-#include <stack>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <optional>
 #include <limits>
-#include <unordered_map>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace cds
 {
@@ -28,92 +36,262 @@ namespace astar
 namespace detail_
 {
 
-template <typename NodeType, typename CostFn, typename ExpandFn, typename NeighborWeightFn, typename IsGoalFn, typename HashFn>
+/// Node storage for IDA* searches that don't check the whole path for cycles.
+/// Holds just the nodes on the current path, so emplace() pushes a node
+/// and erase() pops it. Entries don't move, and aren't destroyed until
+/// they are overwritten, so the path doesn't allocate once it has
+/// reached its deepest point.
+template <typename NodeType, typename InfoType>
+class path_node_stack
+{
+public:
+	using value_type = std::pair<const NodeType, InfoType>;
+	using entry_ptr_t = value_type*;
+
+private:
+	std::deque< std::optional<value_type> > m_entries;
+	size_t m_size = 0;
+
+public:
+	size_t size() const { return m_size; }
+
+	std::pair<entry_ptr_t, bool> emplace(NodeType const& node, InfoType const& info)
+	{
+		if (m_size == m_entries.size())
+			m_entries.emplace_back();
+
+		auto& entry = m_entries[m_size++];
+		entry.emplace(node, info);
+
+		return std::make_pair(&*entry, true);
+	}
+
+	/// Removes the last node on the path (e)
+	void erase(entry_ptr_t e)
+	{
+		(void)e;
+		m_size--;
+	}
+
+	void clear()
+	{
+		m_size = 0;
+	}
+};
+
+/// A successor of a node on the IDA* path, with its cached cost to goal estimate
+template <typename NodeType, typename CostFn>
+struct ida_successor
+{
+	NodeType node;
+	cost_value_t<CostFn, NodeType> cost_to_goal;
+};
+
+/// Search state for one node on the IDA* path: the node's successors
+/// (ordered by their estimated cost to goal), the next one to visit,
+/// and the minimum f-cost that exceeded the bound.
+/// tt_min is the value stored in the transposition table: min, but also
+/// counting the f-cost of each successor skipped by the cycle check,
+/// so that it's a lower bound on any path through the node, and not
+/// just the paths that don't go back through the current path.
+template <typename NodeType, typename CostFn>
+struct ida_frame
+{
+	using cost_t = cost_value_t<CostFn, NodeType>;
+
+	std::vector< ida_successor<NodeType, CostFn> > successors;
+	size_t next;
+	cost_t min;
+	cost_t tt_min;
+};
+
+/// Frame stack for ida_search(). Frames (and their successor lists)
+/// are reused as the search goes deeper and between iterations.
+template <typename NodeType, typename CostFn>
+using ida_frame_stack = std::vector< ida_frame<NodeType, CostFn> >;
+
+/// One depth-first iteration of IDA*, bounded by bound.
+/// path holds the root node's entry on entry (root_cost_to_goal is its
+/// estimated cost to goal), and the path to the goal
+/// node if one was found. Nodes on the path are kept in node_set.
+/// Each node is expanded at most once, and each successor's cost to
+/// goal is computed once when its parent is expanded.
+/// Policy::cycle_check selects how successors already on the path are skipped.
+/// If the policy has a transposition table, (tt) the cost to goal of a successor
+/// that's in the table is raised to its backed up value, and each node whose
+/// subtree has been searched is stored in the table. Successors skipped by the
+/// cycle check are stored with their own f-cost, since they can't be skipped
+/// when the node is reached by another path.
+/// Reports the expanded and generated nodes, and the path depth, to observer.
+/// Stops early, (without finding the goal) once cancelled is set by another thread.
+/// @return Whether the goal was found, and the minimum f-cost that exceeded the bound
+template <	typename Policy,
+				typename NodeType,
+				typename CostFn,
+				typename ExpandFn,
+				typename NeighborWeightFn,
+				typename IsGoalFn,
+				typename NodeSet,
+				typename TranspositionTable,
+				typename Observer >
 auto ida_search(
-		std::stack< typename node_info<NodeType, CostFn>::entry_ptr_t >& path,
-		std::unordered_map<NodeType, node_info<NodeType, CostFn>, HashFn>& node_set,
-		CostFn cost_to_goal_fn,
-		ExpandFn expand,
-		NeighborWeightFn neighbor_weight,
-		IsGoalFn is_goal_fn,
+		std::vector< typename node_info<NodeType, CostFn>::entry_ptr_t >& path,
+		ida_frame_stack<NodeType, CostFn>& frames,
+		NodeSet& node_set,
+		TranspositionTable& tt,
+		CostFn& cost_to_goal_fn,
+		ExpandFn& expand,
+		NeighborWeightFn& neighbor_weight,
+		IsGoalFn& is_goal_fn,
+		cost_value_t<CostFn, NodeType> root_cost_to_goal,
 		cost_value_t<CostFn, NodeType> bound,
-		cost_value_t<CostFn, NodeType> max_cost) -> std::pair<bool, cost_value_t<CostFn, NodeType>>
+		cost_value_t<CostFn, NodeType> max_cost,
+		Observer& observer,
+		std::atomic<bool> const* cancelled = nullptr) -> std::pair<bool, cost_value_t<CostFn, NodeType>>
 {
 	using cost_t = cost_value_t<CostFn, NodeType>;
 	using node_info_t = node_info<NodeType, CostFn>;
+	using successor_t = ida_successor<NodeType, CostFn>;
 
-	auto& node_it = path.top();
+	size_t depth = 0;
 
-	NodeType const& node = node_it->first;
-	node_info_t const& node_info = node_it->second;
-
-	cost_t f = node_info.cost_to_node + cost_to_goal_fn(node);
+	// Evaluates the node at the end of the path, and pushes a frame
+	// for it if it's within the bound and isn't the goal.
+	// h is the node's estimated cost to goal, cost_to_goal is h
+	// or the node's backed up cost from the transposition table.
+	auto visit = [&](cost_t h, cost_t cost_to_goal, cost_t& out_f) -> bool
+	{
+		NodeType const& node = path.back()->first;
 
-	if (f > bound)
-		return std::make_pair(false, f);
+		out_f = path.back()->second.cost_to_node + cost_to_goal;
 
-	if (f > max_cost)
-		return std::make_pair(false, f);
+		if (out_f > bound || out_f > max_cost || is_goal_fn(node))
+			return false;
 
-	if (is_goal_fn(node))
-		return std::make_pair(true, f);
+		if (depth == frames.size())
+			frames.emplace_back();
 
-	cost_t min = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max();
+		observer.node_expanded();
 
-	auto adj_nodes = expand(node);
-	std::sort(adj_nodes.begin(), adj_nodes.end(),
-		[&cost_to_goal_fn](NodeType const& n1, NodeType const& n2)
+		auto& frame = frames[depth++];
+		frame.successors.clear();
+		for (auto&& adj_node : expand(node))
 		{
-			return cost_to_goal_fn(n1) < cost_to_goal_fn(n2);
-		});
-
-	for (NodeType const& adj_node : expand(node))
-	{
-		auto adj_node_it = node_set.find(adj_node);
-		if (adj_node_it == node_set.end())
-		{
-			auto cost_to_adj_node = node_info.cost_to_node + neighbor_weight(node, adj_node);
+			cost_t const adj_cost_to_goal = successor_cost_to_goal(cost_to_goal_fn, node, h, adj_node);
+			frame.successors.push_back(successor_t{ std::forward<decltype(adj_node)>(adj_node), adj_cost_to_goal });
+		}
 
-			if (adj_node_it == node_set.end())
+		std::sort(frame.successors.begin(), frame.successors.end(),
+			[](successor_t const& s1, successor_t const& s2)
 			{
-				tie(adj_node_it, std::ignore) =
-					node_set.emplace(std::make_pair(adj_node, node_info_t{ NodeSetType::CLOSED, cost_to_adj_node }));
-			}
+				return s1.cost_to_goal < s2.cost_to_goal;
+			});
 
-			path.push(&(*adj_node_it));
+		frame.next = 0;
+		frame.min = std::numeric_limits<cost_t>::max();
+		frame.tt_min = std::numeric_limits<cost_t>::max();
 
-			// TODO - no more recursion
-			std::pair<bool, cost_t> t =
-					ida_search(
-							path,
-							node_set,
-							cost_to_goal_fn, expand,
-							neighbor_weight,
-							is_goal_fn,
-							bound,
-							max_cost);
+		return true;
+	};
 
-			if (t.first)
-				return t;
+	cost_t f;
+	if (!visit(root_cost_to_goal, root_cost_to_goal, f))
+		return std::make_pair(f <= bound && f <= max_cost, f);
 
-			if (t.second < min)
-				min = t.second;
+	while (true)
+	{
+		if (cancelled && cancelled->load(std::memory_order_relaxed))
+			return std::make_pair(false, std::numeric_limits<cost_t>::max());
+
+		auto& frame = frames[depth - 1];
+
+		if (frame.next == frame.successors.size())
+		{
+			// All of this node's successors have been searched
+			cost_t const min = frame.min;
+			cost_t const tt_min = frame.tt_min;
+			if (--depth == 0)
+				return std::make_pair(false, min);
 
-			path.pop();
+			if constexpr (!std::is_same_v<TranspositionTable, no_transposition_table>)
+			{
+				// A subtree without any paths out of it is a dead end, but
+				// don't store that, so that the backed up cost can't overflow
+				if (tt_min != std::numeric_limits<cost_t>::max())
+					tt.store(path.back()->first, path.back()->second.cost_to_node, tt_min);
+			}
 
 			// Node is no longer in the path, so remove it from the node set
 			// We could also set the node type to OPEN, like we do for regular
 			// A*, (and check for that when we expand) but the idea here
 			// is to save memory at the cost of CPU usage...
-			node_set.erase(adj_node_it);
+			node_set.erase(path.back());
+			path.pop_back();
+
+			auto& parent_frame = frames[depth - 1];
+			parent_frame.min = std::min(parent_frame.min, min);
+			parent_frame.tt_min = std::min(parent_frame.tt_min, tt_min);
+			continue;
 		}
-	}
 
-	return std::make_pair(false, min);
+		successor_t const& adj = frame.successors[frame.next++];
+
+		bool skip = false;
+		if constexpr (Policy::cycle_check == CycleCheck::PATH)
+			skip = node_set.find(adj.node) != nullptr;	// Already on the path
+		else if constexpr (Policy::cycle_check == CycleCheck::PARENT)
+			skip = path.size() > 1 && adj.node == path[path.size() - 2]->first;	// Don't go straight back
+
+		node_info_t const& node_info = path.back()->second;
+
+		if (skip)
+		{
+			if constexpr (!std::is_same_v<TranspositionTable, no_transposition_table>)
+			{
+				cost_t const skipped_f = node_info.cost_to_node + neighbor_weight(path.back()->first, adj.node) + adj.cost_to_goal;
+				frame.tt_min = std::min(frame.tt_min, skipped_f);
+			}
+
+			continue;
+		}
+
+		auto cost_to_adj_node = node_info.cost_to_node + neighbor_weight(path.back()->first, adj.node);
+
+		cost_t adj_cost_to_goal = adj.cost_to_goal;
+		if constexpr (!std::is_same_v<TranspositionTable, no_transposition_table>)
+		{
+			if (auto const* tt_entry = tt.find(adj.node))
+				adj_cost_to_goal = std::max(adj_cost_to_goal, tt_entry->backed_up_cost - tt_entry->cost_to_node);
+		}
+
+		typename node_info_t::entry_ptr_t adj_node_it;
+		tie(adj_node_it, std::ignore) =
+			node_set.emplace(adj.node, node_info_t{ NodeSetType::CLOSED, cost_to_adj_node });
+
+		path.push_back(adj_node_it);
+
+		observer.node_generated();
+		observer.memory_used(path.size(), 0,
+			path.size() * sizeof(std::remove_pointer_t<typename node_info_t::entry_ptr_t>));
+
+		// visit() may grow the frame stack, so don't use frame after this
+		if (!visit(adj.cost_to_goal, adj_cost_to_goal, f))
+		{
+			if (f <= bound && f <= max_cost)
+				return std::make_pair(true, f);	// Found the goal
+
+			auto& parent_frame = frames[depth - 1];
+			parent_frame.min = std::min(parent_frame.min, f);
+			parent_frame.tt_min = std::min(parent_frame.tt_min, f);
+
+			node_set.erase(path.back());
+			path.pop_back();
+		}
+	}
 }
 
 } // detail_
 
 } // astar
 
-} //cds
\ No newline at end of file
+} //cds
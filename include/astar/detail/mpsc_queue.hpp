@@ -0,0 +1,103 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Lock-free multiple producer, single consumer queue
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Unbounded intrusive MPSC queue (Vyukov's), push() is wait-free
+/// and can be called from any thread, pop() only from the consumer.
+/// The queue always holds a stub node, the oldest element is in the
+/// node after it.
+template <typename T>
+class mpsc_queue
+{
+	struct node
+	{
+		std::atomic<node*> next{nullptr};
+		std::optional<T> value;
+	};
+
+	alignas(64) std::atomic<node*> m_head;	// most recently pushed node, written by the producers
+	alignas(64) node* m_tail;					// stub node, only used by the consumer
+
+public:
+	mpsc_queue()
+	: m_head(new node())
+	, m_tail(m_head.load(std::memory_order_relaxed))
+	{
+
+	}
+
+	mpsc_queue(mpsc_queue const&) = delete;
+	mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+	~mpsc_queue()
+	{
+		while (m_tail)
+		{
+			node* next = m_tail->next.load(std::memory_order_relaxed);
+			delete m_tail;
+			m_tail = next;
+		}
+	}
+
+	void push(T value)
+	{
+		node* n = new node();
+		n->value.emplace(std::move(value));
+
+		node* prev = m_head.exchange(n, std::memory_order_acq_rel);
+		prev->next.store(n, std::memory_order_release);
+	}
+
+	/// Might return std::nullopt while a push() is in progress,
+	/// even though the queue isn't empty
+	std::optional<T> pop()
+	{
+		node* next = m_tail->next.load(std::memory_order_acquire);
+		if (!next)
+			return std::nullopt;
+
+		std::optional<T> value = std::move(next->value);
+		next->value.reset();
+
+		delete m_tail;
+		m_tail = next;	// next is the new stub
+
+		return value;
+	}
+
+	bool empty() const
+	{
+		return m_tail->next.load(std::memory_order_acquire) == nullptr;
+	}
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -14,6 +14,7 @@
 
 #include <utility>
 #include <limits>
+#include <cstddef>
 
 #include <astar/cost_value.hpp>
 
@@ -45,6 +46,9 @@ struct node_info
 	NodeSetType type;
 	cost_value_t<CostFn, NodeType> cost_to_node;
 	entry_ptr_t prev_node;	// pointer to previous node (for A* path reconstruction)
+	size_t heap_index;		// position in an indexed fringe, or npos if not in the fringe
+
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
 
 	node_info() = delete;
 
@@ -52,6 +56,7 @@ struct node_info
 	: type(type)
 	, cost_to_node(cost_to_node)
 	, prev_node(nullptr)
+	, heap_index(npos)
 	{
 
 	}
@@ -62,6 +67,7 @@ struct node_goal_cost_estimate
 {
 	typename node_info<NodeType, CostFn>::entry_ptr_t	node_index;
 	cost_value_t<CostFn, NodeType> cost;
+	cost_value_t<CostFn, NodeType> cost_to_node;	// cost_to_node when this entry was pushed
 
 	bool operator<(node_goal_cost_estimate const& rhs) const
 	{
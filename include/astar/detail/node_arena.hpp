@@ -0,0 +1,244 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Monotonic block arena for search node storage
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Block arena, memory is handed out from large blocks. Deallocated
+/// small chunks go on a free list for their size, and are handed out
+/// again by allocate(). reset() releases everything at once but keeps
+/// the blocks, so an arena that is reused for searches of similar size
+/// stops allocating after the first one.
+class node_arena
+{
+	struct block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+		bool in_use;	// only used for large blocks
+	};
+
+	std::vector<block> m_blocks;
+	size_t m_current = 0;	// index of the block we're allocating from
+	size_t m_offset = 0;		// offset into the current block
+
+	// Allocations larger than half a block (e.g. hash table buckets) get
+	// their own block, which is kept around and reused after a reset()
+	std::vector<block> m_large_blocks;
+
+	size_t m_block_size;
+
+	// Free lists of deallocated small chunks, linked through the chunks themselves.
+	// Node maps only allocate a couple of different sizes, so a few lists are plenty,
+	// chunks of any other size are just dropped until the next reset().
+	struct free_list
+	{
+		size_t bytes;
+		size_t alignment;
+		void* head;
+	};
+
+	static constexpr size_t max_free_lists = 4;
+
+	free_list m_free_lists[max_free_lists] = {};
+	size_t m_num_free_lists = 0;
+
+	free_list* find_free_list_(size_t bytes, size_t alignment)
+	{
+		for (size_t i = 0 ; i < m_num_free_lists ; i++)
+			if (m_free_lists[i].bytes == bytes && m_free_lists[i].alignment == alignment)
+				return &m_free_lists[i];
+
+		return nullptr;
+	}
+
+	static void* align_(std::byte* p, size_t alignment)
+	{
+		uintptr_t const u = reinterpret_cast<uintptr_t>(p);
+		return reinterpret_cast<void*>((u + alignment - 1) & ~(uintptr_t(alignment) - 1));
+	}
+
+	void* allocate_large_(size_t bytes, size_t alignment)
+	{
+		for (block& b : m_large_blocks)
+		{
+			if (!b.in_use && b.size >= bytes + alignment)
+			{
+				b.in_use = true;
+				return align_(b.data.get(), alignment);
+			}
+		}
+
+		size_t const size = bytes + alignment;
+		m_large_blocks.push_back(block{ std::make_unique<std::byte[]>(size), size, true });
+
+		return align_(m_large_blocks.back().data.get(), alignment);
+	}
+
+public:
+	static constexpr size_t default_block_size = 1 << 16;
+
+	explicit node_arena(size_t block_size = default_block_size)
+		: m_block_size(block_size)
+	{
+
+	}
+
+	node_arena(node_arena const&) = delete;
+	node_arena& operator=(node_arena const&) = delete;
+
+	void* allocate(size_t bytes, size_t alignment)
+	{
+		if (bytes > m_block_size / 2)
+			return allocate_large_(bytes, alignment);
+
+		if (m_num_free_lists > 0)
+		{
+			free_list* const fl = find_free_list_(bytes, alignment);
+			if (fl && fl->head)
+			{
+				void* const p = fl->head;
+				fl->head = *static_cast<void**>(p);
+				return p;
+			}
+		}
+
+		while (m_current < m_blocks.size())
+		{
+			block& b = m_blocks[m_current];
+			std::byte* const p = static_cast<std::byte*>(align_(b.data.get() + m_offset, alignment));
+
+			if (p + bytes <= b.data.get() + b.size)
+			{
+				m_offset = (p - b.data.get()) + bytes;
+				return p;
+			}
+
+			// Doesn't fit, move on to the next block
+			m_current++;
+			m_offset = 0;
+		}
+
+		m_blocks.push_back(block{ std::make_unique<std::byte[]>(m_block_size), m_block_size, true });
+		m_current = m_blocks.size() - 1;
+		m_offset = 0;
+
+		return allocate(bytes, alignment);
+	}
+
+	/// Puts a small chunk on the free list for its size and alignment, so
+	/// allocate() can hand it out again. Large allocations are released by reset().
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept
+	{
+		if (bytes > m_block_size / 2 || bytes < sizeof(void*) || alignment < alignof(void*))
+			return;
+
+		free_list* fl = find_free_list_(bytes, alignment);
+		if (!fl)
+		{
+			if (m_num_free_lists == max_free_lists)
+				return;
+
+			fl = &m_free_lists[m_num_free_lists++];
+			*fl = free_list{ bytes, alignment, nullptr };
+		}
+
+		*static_cast<void**>(p) = fl->head;
+		fl->head = p;
+	}
+
+	/// Makes all the memory in the arena available again, without freeing any blocks.
+	/// Everything allocated from the arena must be destroyed first.
+	void reset()
+	{
+		m_current = 0;
+		m_offset = 0;
+		m_num_free_lists = 0;
+
+		for (block& b : m_large_blocks)
+			b.in_use = false;
+	}
+
+	/// Total size of the blocks owned by the arena
+	size_t capacity() const
+	{
+		size_t c = 0;
+		for (block const& b : m_blocks)
+			c += b.size;
+		for (block const& b : m_large_blocks)
+			c += b.size;
+
+		return c;
+	}
+};
+
+/// Standard allocator that allocates from a node_arena
+template <typename T>
+class arena_allocator
+{
+	node_arena* m_arena;
+
+	template <typename U> friend class arena_allocator;
+
+public:
+	using value_type = T;
+
+	explicit arena_allocator(node_arena& arena) noexcept
+		: m_arena(&arena)
+	{
+
+	}
+
+	template <typename U>
+	arena_allocator(arena_allocator<U> const& other) noexcept
+		: m_arena(other.m_arena)
+	{
+
+	}
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		m_arena->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	template <typename U>
+	bool operator==(arena_allocator<U> const& rhs) const { return m_arena == rhs.m_arena; }
+
+	template <typename U>
+	bool operator!=(arena_allocator<U> const& rhs) const { return m_arena != rhs.m_arena; }
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,155 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Node storage for the search engines.
+// All of them share the same interface, and store std::pair<const NodeType, InfoType>
+// entries that don't move, so entry pointers can be used as node handles:
+//		find(node)				- pointer to the node's entry, or nullptr
+//		emplace(node, info)	- pair of (entry pointer, inserted?)
+//		erase(entry)
+//		size(), clear()
+
+#pragma once
+
+#include <unordered_map>
+#include <new>
+#include <memory>
+#include <functional>
+#include <utility>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/node_arena.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// std::unordered_map node storage
+template <typename NodeType, typename InfoType, typename HashFn>
+class std_node_map
+{
+	using map_t = std::unordered_map<NodeType, InfoType, HashFn>;
+
+	map_t m_map;
+
+public:
+	using entry_ptr_t = node_map_entry_ptr_t<NodeType, InfoType>;
+
+	entry_ptr_t find(NodeType const& n)
+	{
+		auto it = m_map.find(n);
+		return it != m_map.end() ? &(*it) : nullptr;
+	}
+
+	std::pair<entry_ptr_t, bool> emplace(NodeType const& n, InfoType const& info)
+	{
+		auto r = m_map.emplace(n, info);
+		return std::make_pair(&(*r.first), r.second);
+	}
+
+	void erase(entry_ptr_t e)
+	{
+		m_map.erase(m_map.find(e->first));
+	}
+
+	size_t size() const { return m_map.size(); }
+
+	void clear() { m_map.clear(); }
+};
+
+/// std::unordered_map node storage, with the map's nodes (and buckets) allocated
+/// from a node_arena. clear() rewinds the arena, so a map that is reused for
+/// searches of similar size doesn't allocate after the first one. Erased
+/// entries go on the arena's free list, so an IDA* path check that erases
+/// on every backtrack only needs memory for the path.
+template <typename NodeType, typename InfoType, typename HashFn>
+class arena_node_map
+{
+	using value_type = std::pair<const NodeType, InfoType>;
+	using allocator_t = arena_allocator<value_type>;
+	using map_t = std::unordered_map<NodeType, InfoType, HashFn, std::equal_to<NodeType>, allocator_t>;
+
+	/// The map is allocated from the arena too, so it's only destroyed, not freed
+	struct map_deleter
+	{
+		void operator()(map_t* m) const { m->~map_t(); }
+	};
+
+	std::unique_ptr<node_arena> m_arena;	// the map holds a pointer to this, so keep it put
+	std::unique_ptr<map_t, map_deleter> m_map;
+
+	void create_map(size_t bucket_count)
+	{
+		void* const p = m_arena->allocate(sizeof(map_t), alignof(map_t));
+		m_map.reset(new (p) map_t(bucket_count, HashFn(), std::equal_to<NodeType>(), allocator_t(*m_arena)));
+	}
+
+public:
+	using entry_ptr_t = node_map_entry_ptr_t<NodeType, InfoType>;
+
+	arena_node_map()
+		: m_arena(std::make_unique<node_arena>())
+	{
+		create_map(0);
+	}
+
+	arena_node_map(arena_node_map&&) = default;
+
+	arena_node_map& operator=(arena_node_map&& other) noexcept
+	{
+		// Destroy this map before its arena
+		m_map = std::move(other.m_map);
+		m_arena = std::move(other.m_arena);
+		return *this;
+	}
+
+	entry_ptr_t find(NodeType const& n)
+	{
+		auto it = m_map->find(n);
+		return it != m_map->end() ? &(*it) : nullptr;
+	}
+
+	std::pair<entry_ptr_t, bool> emplace(NodeType const& n, InfoType const& info)
+	{
+		auto r = m_map->emplace(n, info);
+		return std::make_pair(&(*r.first), r.second);
+	}
+
+	void erase(entry_ptr_t e)
+	{
+		m_map->erase(m_map->find(e->first));
+	}
+
+	size_t size() const { return m_map->size(); }
+
+	void clear()
+	{
+		size_t const bucket_count = m_map->bucket_count();
+
+		m_map.reset();
+		m_arena->reset();
+		create_map(bucket_count);
+	}
+
+	node_arena const& arena() const { return *m_arena; }
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,378 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Open lists (fringes) for A* search.
+// All of them share the same interface:
+//		push(node_goal_cost_estimate)	- insert a node, or update it if it's already in the fringe
+//		pop()									- remove and return the lowest cost entry
+//		empty(), size(), clear()
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include <astar/detail/node.hpp>
+#include <astar/cost_value.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Binary heap fringe (like std::priority_queue, but clear() keeps the storage).
+/// Updating a node pushes a duplicate entry, the old (stale) entry
+/// stays in the queue until it is popped.
+template <typename NodeType, typename CostFn>
+class lazy_open_list
+{
+public:
+	using value_type = node_goal_cost_estimate<NodeType, CostFn>;
+
+private:
+	std::vector<value_type> m_heap;
+
+public:
+	bool empty() const { return m_heap.empty(); }
+	size_t size() const { return m_heap.size(); }
+
+	void push(value_type const& v)
+	{
+		m_heap.push_back(v);
+		std::push_heap(m_heap.begin(), m_heap.end());
+	}
+
+	value_type pop()
+	{
+		std::pop_heap(m_heap.begin(), m_heap.end());
+		value_type v = m_heap.back();
+		m_heap.pop_back();
+
+		return v;
+	}
+
+	/// Removes all entries, but keeps the allocated storage
+	void clear()
+	{
+		m_heap.clear();
+	}
+};
+
+/// Indexed d-ary min-heap fringe with decrease-key.
+/// Each node's position in the heap is kept in node_info::heap_index,
+/// so a node is in the heap at most once.
+template <typename NodeType, typename CostFn, size_t D>
+class d_ary_heap_open_list
+{
+	static_assert(D >= 2, "Invalid heap arity");
+
+public:
+	using value_type = node_goal_cost_estimate<NodeType, CostFn>;
+
+private:
+	using node_info_t = node_info<NodeType, CostFn>;
+
+	std::vector<value_type> m_heap;
+
+	void place_(size_t i, value_type const& v)
+	{
+		m_heap[i] = v;
+		v.node_index->second.heap_index = i;
+	}
+
+	void sift_up_(size_t i)
+	{
+		value_type const v = m_heap[i];
+		while (i > 0)
+		{
+			size_t const parent = (i - 1) / D;
+			if (!(v.cost < m_heap[parent].cost))
+				break;
+
+			place_(i, m_heap[parent]);
+			i = parent;
+		}
+
+		place_(i, v);
+	}
+
+	void sift_down_(size_t i)
+	{
+		value_type const v = m_heap[i];
+		size_t const n = m_heap.size();
+		while (true)
+		{
+			size_t const first_child = D * i + 1;
+			if (first_child >= n)
+				break;
+
+			size_t const last_child = std::min(first_child + D, n);
+			size_t min_child = first_child;
+			for (size_t c = first_child + 1 ; c < last_child ; c++)
+				if (m_heap[c].cost < m_heap[min_child].cost)
+					min_child = c;
+
+			if (!(m_heap[min_child].cost < v.cost))
+				break;
+
+			place_(i, m_heap[min_child]);
+			i = min_child;
+		}
+
+		place_(i, v);
+	}
+
+public:
+	bool empty() const { return m_heap.empty(); }
+	size_t size() const { return m_heap.size(); }
+
+	void push(value_type const& v)
+	{
+		size_t const i = v.node_index->second.heap_index;
+		if (i == node_info_t::npos)
+		{
+			m_heap.push_back(v);
+			sift_up_(m_heap.size() - 1);
+			return;
+		}
+
+		// Already in the heap, update its cost
+		bool const decreased = v.cost < m_heap[i].cost;
+		m_heap[i] = v;
+		if (decreased)
+			sift_up_(i);
+		else
+			sift_down_(i);
+	}
+
+	value_type pop()
+	{
+		value_type const top = m_heap.front();
+		top.node_index->second.heap_index = node_info_t::npos;
+
+		value_type const last = m_heap.back();
+		m_heap.pop_back();
+		if (!m_heap.empty())
+		{
+			m_heap.front() = last;
+			sift_down_(0);
+		}
+
+		return top;
+	}
+
+	/// Removes all entries, but keeps the allocated storage.
+	/// Doesn't reset the heap index of the removed nodes.
+	void clear()
+	{
+		m_heap.clear();
+	}
+};
+
+/// Bucket queue fringe for integral cost types, push and pop are O(1)
+/// (amortized) as long as the f-values fall in a narrow range.
+/// Entries are bucketed by f, then by g; ties on f are broken in
+/// favor of the larger g (i.e. the node closest to the goal).
+/// There's a bucket for each f in the range of f-values, and within those,
+/// one for each g from the smallest in the f bucket to the largest, so
+/// memory grows with both ranges.
+/// node_info::heap_index is the entry's slot, so updates remove
+/// the old entry rather than leaving a stale one behind.
+template <typename NodeType, typename CostFn>
+class bucket_open_list
+{
+	using cost_t = cost_value_t<CostFn, NodeType>;
+
+	static_assert(std::is_integral_v<cost_t>, "bucket_open_list requires an integral cost type");
+
+public:
+	using value_type = node_goal_cost_estimate<NodeType, CostFn>;
+
+private:
+	using node_info_t = node_info<NodeType, CostFn>;
+
+	struct slot
+	{
+		value_type value;
+		size_t bucket_pos;	// position in m_buckets[f][g]
+	};
+
+	struct f_bucket
+	{
+		std::vector< std::vector<size_t> > by_g;	// slot indices, indexed by g - g_base
+		cost_t g_base = 0;	// smallest g since the bucket was last empty
+		size_t count = 0;
+		size_t max_g = 0;	// no non-empty g bucket above this (relative to g_base)
+	};
+
+	std::vector<slot> m_slots;
+	std::vector<size_t> m_free_slots;
+
+	std::vector<f_bucket> m_buckets;	// indexed by f - m_base
+	cost_t m_base = 0;
+	size_t m_min_bucket = 0;				// no non-empty f bucket below this
+	size_t m_size = 0;
+
+	std::vector<size_t>& bucket_(value_type const& v)
+	{
+		if (m_size == 0)
+		{
+			// Every bucket is empty, so they can start at v's f
+			m_base = v.cost;
+			m_min_bucket = 0;
+		}
+
+		if (v.cost < m_base)
+		{
+			// Lower f than anything we've seen, make room at the front
+			size_t const shift = static_cast<size_t>(m_base - v.cost);
+			m_buckets.insert(m_buckets.begin(), shift, f_bucket());
+			m_min_bucket += shift;
+			m_base = v.cost;
+		}
+
+		size_t const f_idx = static_cast<size_t>(v.cost - m_base);
+		if (f_idx >= m_buckets.size())
+			m_buckets.resize(f_idx + 1);
+
+		f_bucket& fb = m_buckets[f_idx];
+		if (fb.count == 0)
+		{
+			fb.g_base = v.cost_to_node;
+			fb.max_g = 0;
+		}
+		else if (v.cost_to_node < fb.g_base)
+		{
+			// Lower g than anything in this f bucket, make room at the front
+			size_t const shift = static_cast<size_t>(fb.g_base - v.cost_to_node);
+			fb.by_g.insert(fb.by_g.begin(), shift, std::vector<size_t>());
+			fb.max_g += shift;
+			fb.g_base = v.cost_to_node;
+		}
+
+		size_t const g_idx = static_cast<size_t>(v.cost_to_node - fb.g_base);
+		if (g_idx >= fb.by_g.size())
+			fb.by_g.resize(g_idx + 1);
+
+		return fb.by_g[g_idx];
+	}
+
+	void insert_(size_t slot_idx)
+	{
+		value_type const& v = m_slots[slot_idx].value;
+		std::vector<size_t>& b = bucket_(v);
+
+		size_t const f_idx = static_cast<size_t>(v.cost - m_base);
+		f_bucket& fb = m_buckets[f_idx];
+		fb.count++;
+		fb.max_g = std::max(fb.max_g, static_cast<size_t>(v.cost_to_node - fb.g_base));
+		m_min_bucket = std::min(m_min_bucket, f_idx);
+
+		m_slots[slot_idx].bucket_pos = b.size();
+		b.push_back(slot_idx);
+		m_size++;
+	}
+
+	void remove_(size_t slot_idx)
+	{
+		value_type const& v = m_slots[slot_idx].value;
+		f_bucket& fb = m_buckets[static_cast<size_t>(v.cost - m_base)];
+		std::vector<size_t>& b = fb.by_g[static_cast<size_t>(v.cost_to_node - fb.g_base)];
+
+		size_t const pos = m_slots[slot_idx].bucket_pos;
+		b[pos] = b.back();
+		m_slots[b[pos]].bucket_pos = pos;
+		b.pop_back();
+
+		fb.count--;
+		m_size--;
+	}
+
+public:
+	bool empty() const { return m_size == 0; }
+	size_t size() const { return m_size; }
+
+	void push(value_type const& v)
+	{
+		size_t slot_idx = v.node_index->second.heap_index;
+		if (slot_idx != node_info_t::npos)
+		{
+			// Already in the fringe, move it to its new bucket
+			remove_(slot_idx);
+		}
+		else if (!m_free_slots.empty())
+		{
+			slot_idx = m_free_slots.back();
+			m_free_slots.pop_back();
+		}
+		else
+		{
+			slot_idx = m_slots.size();
+			m_slots.emplace_back();
+		}
+
+		m_slots[slot_idx].value = v;
+		v.node_index->second.heap_index = slot_idx;
+
+		insert_(slot_idx);
+	}
+
+	value_type pop()
+	{
+		while (m_buckets[m_min_bucket].count == 0)
+			m_min_bucket++;
+
+		f_bucket& fb = m_buckets[m_min_bucket];
+		while (fb.by_g[fb.max_g].empty())
+			fb.max_g--;
+
+		size_t const slot_idx = fb.by_g[fb.max_g].back();
+		value_type const top = m_slots[slot_idx].value;
+
+		remove_(slot_idx);
+		m_free_slots.push_back(slot_idx);
+		top.node_index->second.heap_index = node_info_t::npos;
+
+		return top;
+	}
+
+	/// Removes all entries, but keeps the allocated storage.
+	/// Doesn't reset the heap index of the removed nodes.
+	void clear()
+	{
+		for (f_bucket& fb : m_buckets)
+		{
+			for (auto& b : fb.by_g)
+				b.clear();
+
+			fb.count = 0;
+			fb.max_g = 0;
+		}
+
+		m_slots.clear();
+		m_free_slots.clear();
+		m_min_bucket = 0;
+		m_size = 0;
+	}
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,124 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Fixed size pool of threads that all run the same job
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Threads that wait for a job, and then run it together. run() runs the
+/// job on every thread, (including the calling thread, as worker 0) and
+/// waits for all of them to finish. The threads are reused for each job.
+class thread_pool
+{
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_job_cv;
+	std::condition_variable m_done_cv;
+
+	std::function<void(size_t)> m_job;
+	size_t m_generation = 0;	// number of jobs started
+	size_t m_num_running = 0;
+	bool m_stop = false;
+
+	void thread_main_(size_t worker_index)
+	{
+		size_t generation = 0;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_job_cv.wait(lock, [this, generation] { return m_stop || m_generation != generation; });
+				if (m_stop)
+					return;
+
+				generation = m_generation;
+			}
+
+			m_job(worker_index);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_num_running == 0)
+				m_done_cv.notify_one();
+		}
+	}
+
+public:
+	/// @param num_threads Number of workers, including the calling thread.
+	///			0 uses std::thread::hardware_concurrency()
+	explicit thread_pool(unsigned int num_threads = 0)
+	{
+		if (num_threads == 0)
+			num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+		for (size_t i = 1 ; i < num_threads ; i++)
+			m_threads.emplace_back(&thread_pool::thread_main_, this, i);
+	}
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+
+		m_job_cv.notify_all();
+		for (std::thread& t : m_threads)
+			t.join();
+	}
+
+	thread_pool(thread_pool const&) = delete;
+	thread_pool& operator=(thread_pool const&) = delete;
+
+	size_t size() const { return m_threads.size() + 1; }
+
+	/// Calls job(worker_index) on every worker, and returns once they're all done
+	void run(std::function<void(size_t)> job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = std::move(job);
+			m_num_running = m_threads.size();
+			m_generation++;
+		}
+
+		m_job_cv.notify_all();
+
+		m_job(0);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done_cv.wait(lock, [this] { return m_num_running == 0; });
+	}
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
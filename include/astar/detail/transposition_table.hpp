@@ -0,0 +1,164 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <functional>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Memory-bounded (direct mapped) transposition table for IDA*.
+/// Stores the cost to a node and the f-cost backed up from its searched
+/// subtree, (the minimum f-cost that exceeded the bound) so that
+/// backed_up_cost - cost_to_node is a better estimate of the node's
+/// cost to goal. Entries are replaced when another node hashes to
+/// the same slot. The table starts small and doubles in size when it's
+/// half full, until it reaches its memory budget.
+template <typename NodeType, typename Cost, typename HashFn = std::hash<NodeType>>
+class transposition_table
+{
+public:
+	struct entry
+	{
+		Cost cost_to_node;
+		Cost backed_up_cost;
+	};
+
+private:
+	struct slot
+	{
+		std::optional<NodeType> node;
+		entry value;
+	};
+
+	static constexpr size_t initial_num_slots = 1024;
+
+	std::vector<slot> m_slots;
+	size_t m_mask;
+	size_t m_max_slots;
+	size_t m_size = 0;
+	HashFn m_hash;
+
+	slot& slot_(NodeType const& node)
+	{
+		size_t h = m_hash(node);
+		h ^= h >> 29;
+		h *= 0x9E3779B97F4A7C15ull;
+		h ^= h >> 32;
+
+		return m_slots[h & m_mask];
+	}
+
+	void grow_()
+	{
+		std::vector<slot> old_slots(m_slots.size() * 2);
+		old_slots.swap(m_slots);
+		m_mask = m_slots.size() - 1;
+		m_size = 0;
+
+		for (slot& s : old_slots)
+		{
+			if (!s.node.has_value())
+				continue;
+
+			slot& new_s = slot_(*s.node);
+			if (!new_s.node.has_value())
+				m_size++;
+
+			new_s = std::move(s);
+		}
+	}
+
+public:
+	/// Uses at most max_bytes for the table, including while it grows
+	/// (but always holds at least one entry)
+	explicit transposition_table(size_t max_bytes, HashFn const& hash = HashFn())
+		: m_hash(hash)
+	{
+		// grow_() keeps the old slots until they've been moved to the new ones
+		auto const peak_bytes = [](size_t num_slots)
+		{
+			if (num_slots > initial_num_slots)
+				num_slots += num_slots / 2;
+
+			return num_slots * sizeof(slot);
+		};
+
+		m_max_slots = 1;
+		while (peak_bytes(m_max_slots * 2) <= max_bytes)
+			m_max_slots *= 2;
+
+		m_slots.resize(std::min(m_max_slots, initial_num_slots));
+		m_mask = m_slots.size() - 1;
+	}
+
+	/// @return The node's entry, or nullptr if it isn't in the table
+	entry const* find(NodeType const& node)
+	{
+		slot& s = slot_(node);
+		return s.node.has_value() && *s.node == node ? &s.value : nullptr;
+	}
+
+	void store(NodeType const& node, Cost cost_to_node, Cost backed_up_cost)
+	{
+		if (m_size * 2 >= m_slots.size() && m_slots.size() < m_max_slots)
+			grow_();
+
+		slot& s = slot_(node);
+		if (!s.node.has_value())
+			m_size++;
+
+		if (!s.node.has_value() || !(*s.node == node))
+			s.node.emplace(node);
+
+		s.value = entry{ cost_to_node, backed_up_cost };
+	}
+
+	void clear()
+	{
+		for (slot& s : m_slots)
+			s.node.reset();
+
+		m_size = 0;
+	}
+
+	/// Number of occupied entries
+	size_t size() const { return m_size; }
+
+	/// Current number of entries
+	size_t capacity() const { return m_slots.size(); }
+
+	/// Maximum number of entries
+	size_t max_capacity() const { return m_max_slots; }
+
+	/// Current size of the table, in bytes
+	size_t memory_size() const { return m_slots.size() * sizeof(slot); }
+
+	/// Maximum size of the table, in bytes
+	size_t max_memory_size() const { return m_max_slots * sizeof(slot); }
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
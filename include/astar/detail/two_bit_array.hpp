@@ -0,0 +1,109 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Array of 2-bit values that threads can update concurrently
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// Packed 2-bit values, 32 to a 64-bit word. Reads and compare_exchange()
+/// are atomic, so threads can claim values without any locks.
+class two_bit_array
+{
+	std::vector< std::atomic<uint64_t> > m_words;
+	size_t m_size;
+
+	static constexpr uint64_t low_bits = 0x5555555555555555ull;	// the low bit of each value
+
+public:
+	static constexpr size_t values_per_word = 32;
+
+	two_bit_array(size_t size, unsigned int value)
+		: m_words((size + values_per_word - 1) / values_per_word)
+		, m_size(size)
+	{
+		for (auto& w : m_words)
+			w.store(repeated(value), std::memory_order_relaxed);
+	}
+
+	/// value in every position of a word
+	static uint64_t repeated(unsigned int value) { return low_bits * (value & 3); }
+
+	/// Bit mask with the low bit of each value in word that is equal to value
+	static uint64_t matches(uint64_t word, unsigned int value)
+	{
+		uint64_t const diff = word ^ repeated(value);
+		return ~(diff | (diff >> 1)) & low_bits;
+	}
+
+	size_t size() const { return m_size; }
+
+	size_t num_words() const { return m_words.size(); }
+
+	/// The values at [w * values_per_word, (w + 1) * values_per_word).
+	/// Positions after the end of the array keep their initial value.
+	uint64_t word(size_t w) const { return m_words[w].load(std::memory_order_relaxed); }
+
+	unsigned int get(size_t i) const
+	{
+		return static_cast<unsigned int>(word(i / values_per_word) >> (2 * (i % values_per_word))) & 3;
+	}
+
+	/// Sets the value at i to desired, if it is expected.
+	/// @return Whether it was expected (and this call changed it)
+	bool compare_exchange(size_t i, unsigned int expected, unsigned int desired)
+	{
+		std::atomic<uint64_t>& w = m_words[i / values_per_word];
+		unsigned int const shift = 2 * (i % values_per_word);
+
+		uint64_t current = w.load(std::memory_order_relaxed);
+		do
+		{
+			if (((current >> shift) & 3) != expected)
+				return false;
+		}
+		while (!w.compare_exchange_weak(current,
+			(current & ~(uint64_t(3) << shift)) | (uint64_t(desired) << shift), std::memory_order_relaxed));
+
+		return true;
+	}
+
+	/// Sets the values in word w that are marked in mask (by their low bits) to value.
+	/// Other threads may change the word's other values at the same time.
+	void reset(size_t w, uint64_t mask, unsigned int value)
+	{
+		uint64_t const bits = mask | (mask << 1);
+		if (value != 0)
+			m_words[w].fetch_or(bits & repeated(value), std::memory_order_relaxed);
+		if (value != 3)
+			m_words[w].fetch_and(~bits | repeated(value), std::memory_order_relaxed);
+	}
+};
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
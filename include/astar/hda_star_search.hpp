@@ -0,0 +1,404 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Hash Distributed A* (HDA*) search
+// Each node is owned by one of the worker threads, chosen by its hash. A worker
+// only expands the nodes it owns, using its own node storage and fringe, and
+// sends the nodes it generates that other workers own to their (lock-free) inboxes.
+
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/a_star_search.hpp>
+#include <astar/detail/mpsc_queue.hpp>
+#include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/search_stats.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// State that the HDA* workers share
+template <typename Cost>
+struct hda_shared_state
+{
+	/// Cost of the cheapest path found so far, nodes whose
+	/// f-cost is at least this can't lead to a better path
+	alignas(64) std::atomic<Cost> incumbent_cost{std::numeric_limits<Cost>::max()};
+
+	/// Number of workers that are busy, plus the number of batches of nodes that have
+	/// been sent to a worker but not received yet. Once this is 0, it stays 0: idle
+	/// workers only become busy when they receive a batch, and only busy workers send
+	/// batches. So that is when the search is done.
+	alignas(64) std::atomic<size_t> work{0};
+
+	void update_incumbent(Cost cost)
+	{
+		Cost cur = incumbent_cost.load(std::memory_order_relaxed);
+		while (cost < cur && !incumbent_cost.compare_exchange_weak(cur, cost, std::memory_order_relaxed))
+			;
+	}
+};
+
+/// One HDA* worker thread's nodes, fringe, and inbox
+template <typename Policy, typename NodeType, typename CostFn, typename HashFn>
+struct hda_worker
+{
+	using node_info_t =			node_info<NodeType, CostFn>;
+	using entry_ptr_t =			typename node_info_t::entry_ptr_t;
+	using node_collection_t =	typename Policy::node_storage::template type<NodeType, node_info_t, HashFn>;
+	using fringe_t =				typename Policy::fringe::template type<NodeType, CostFn>;
+	using node_goal_cost_est_t =	node_goal_cost_estimate<NodeType, CostFn>;
+	using cost_t =					cost_value_t<CostFn, NodeType>;
+
+	/// A generated node, with the cost of the path to it, and its parent
+	/// (which is in the sending worker's node storage) and the parent's
+	/// estimated cost to goal
+	struct message
+	{
+		NodeType node;
+		cost_t cost_to_node;
+		entry_ptr_t prev_node;
+		cost_t prev_cost_to_goal;
+	};
+
+	using batch_t = std::vector<message>;
+
+	node_collection_t nodes;
+	fringe_t fringe;
+	mpsc_queue<batch_t> inbox;
+	std::vector<batch_t> outboxes;	// one per worker
+
+	entry_ptr_t goal = nullptr;		// cheapest goal node this worker found
+
+	search_stats stats;	// reported to the observer after the search
+};
+
+/// Which of num_workers workers owns a node
+template <typename HashFn, typename NodeType>
+size_t hda_owner(HashFn const& hash_fn, NodeType const& n, size_t num_workers)
+{
+	// Mix the bits (std::hash is often the identity function), and use the upper ones,
+	// the node storage will be indexing with the lower bits of the same hash.
+	uint64_t const h = static_cast<uint64_t>(hash_fn(n)) * 0x9E3779B97F4A7C15ull;
+	return static_cast<size_t>(((h >> 32) * num_workers) >> 32);
+}
+
+/// Worker thread loop
+template <	typename Policy,
+				typename Worker,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename HashFn >
+void hda_worker_loop(
+	size_t worker_index,
+	std::vector<std::unique_ptr<Worker>>& workers,
+	hda_shared_state<typename Worker::cost_t>& shared,
+	ExpandFn& expand_fn,
+	CostFn& cost_to_goal_fn,
+	WeightFn& neighbor_weight_fn,
+	IsGoalFn& is_goal,
+	typename Worker::cost_t max_cost)
+{
+	using cost_t = typename Worker::cost_t;
+	using node_info_t = typename Worker::node_info_t;
+	using entry_ptr_t = typename Worker::entry_ptr_t;
+	using message_t = typename Worker::message;
+
+	// Sending a batch every few expansions keeps the other workers busy,
+	// without paying for a queue push for every node
+	constexpr size_t max_batch_size = 64;
+	constexpr size_t expansions_per_flush = 16;
+
+	Worker& self = *workers[worker_index];
+	size_t const num_workers = workers.size();
+	HashFn const hash_fn;
+
+	auto flush = [&self, &workers, &shared](size_t to)
+	{
+		auto& outbox = self.outboxes[to];
+		if (outbox.empty())
+			return;
+
+		shared.work.fetch_add(1, std::memory_order_acq_rel);
+		workers[to]->inbox.push(std::move(outbox));
+		outbox = typename Worker::batch_t();
+		outbox.reserve(max_batch_size);
+	};
+
+	auto flush_all = [&flush, num_workers]
+	{
+		for (size_t i = 0 ; i < num_workers ; i++)
+			flush(i);
+	};
+
+	// Adds a node that this worker owns
+	auto add_node = [&self, &shared, &cost_to_goal_fn, max_cost](message_t const& m)
+	{
+		entry_ptr_t node_it = self.nodes.find(m.node);
+		if (!node_it)
+			std::tie(node_it, std::ignore) = self.nodes.emplace(m.node, node_info_t(NodeSetType::OPEN, m.cost_to_node));
+		else if (m.cost_to_node >= node_it->second.cost_to_node)
+			return;	// Sub-optimal path
+		else if (node_it->second.type == NodeSetType::CLOSED)
+			self.stats.nodes_reopened++;
+
+		self.stats.nodes_generated++;
+
+		node_it->second.type = NodeSetType::OPEN;
+		node_it->second.prev_node = m.prev_node;
+		node_it->second.cost_to_node = m.cost_to_node;
+
+		cost_t const cost_to_goal = m.prev_node ?
+			successor_cost_to_goal(cost_to_goal_fn, m.prev_node->first, m.prev_cost_to_goal, m.node) :
+			cost_to_goal_fn(m.node);
+
+		cost_t const f_score = m.cost_to_node + cost_to_goal;
+		if (f_score < shared.incumbent_cost.load(std::memory_order_relaxed) && f_score <= max_cost)
+			self.fringe.push(typename Worker::node_goal_cost_est_t{node_it, f_score, m.cost_to_node});
+	};
+
+	size_t expansions_since_flush = 0;
+
+	while (true)
+	{
+		while (auto batch = self.inbox.pop())
+		{
+			for (message_t const& m : *batch)
+				add_node(m);
+
+			shared.work.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		bool made_progress = false;
+		while (!self.fringe.empty())
+		{
+			auto min_cost_node = self.fringe.pop();
+			node_info_t& n_info = min_cost_node.node_index->second;
+
+			if (n_info.type == NodeSetType::CLOSED || min_cost_node.cost_to_node > n_info.cost_to_node)
+			{
+				self.stats.stale_entries++;
+				continue;
+			}
+
+			if (min_cost_node.cost >= shared.incumbent_cost.load(std::memory_order_relaxed))
+			{
+				// Nothing left in the fringe can lead to a cheaper path. Pop the entries
+				// rather than clear() them, so that an indexed fringe forgets their
+				// heap index, (a cheaper path to them might still come in)
+				while (!self.fringe.empty())
+					self.fringe.pop();
+
+				break;
+			}
+
+			auto const& n = min_cost_node.node_index->first;
+			n_info.type = NodeSetType::CLOSED;
+
+			if (is_goal(n))
+			{
+				// Nodes are expanded out of order, so there might still be a cheaper path
+				if (!self.goal || n_info.cost_to_node < self.goal->second.cost_to_node)
+					self.goal = min_cost_node.node_index;
+
+				shared.update_incumbent(n_info.cost_to_node);
+				made_progress = true;
+				break;
+			}
+
+			self.stats.nodes_expanded++;
+
+			cost_t const n_cost_to_goal = min_cost_node.cost - min_cost_node.cost_to_node;
+
+			auto neighbors = expand_fn(n);
+			for (auto adj_node : neighbors)
+			{
+				message_t m{std::move(adj_node), n_info.cost_to_node, min_cost_node.node_index, n_cost_to_goal};
+				m.cost_to_node += neighbor_weight_fn(n, m.node);
+
+				size_t const owner = num_workers > 1 ? hda_owner(hash_fn, m.node, num_workers) : 0;
+				if (owner == worker_index)
+					add_node(m);
+				else
+				{
+					self.outboxes[owner].push_back(std::move(m));
+					if (self.outboxes[owner].size() >= max_batch_size)
+						flush(owner);
+				}
+			}
+
+			if (++expansions_since_flush >= expansions_per_flush)
+			{
+				flush_all();
+				expansions_since_flush = 0;
+			}
+
+			made_progress = true;
+			break;
+		}
+
+		if (made_progress)
+			continue;
+
+		// Nothing to do, make sure the other workers get our nodes before going idle
+		flush_all();
+		expansions_since_flush = 0;
+
+		if (!self.inbox.empty())
+			continue;
+
+		shared.work.fetch_sub(1, std::memory_order_acq_rel);
+		while (true)
+		{
+			if (!self.inbox.empty())
+			{
+				shared.work.fetch_add(1, std::memory_order_acq_rel);
+				break;
+			}
+
+			if (shared.work.load(std::memory_order_acquire) == 0)
+				return;
+
+			std::this_thread::yield();
+		}
+	}
+}
+
+} // namespace detail_
+
+/// Implicit graph A* search, run in parallel by num_threads worker threads (HDA*).
+/// expand_fn, cost_to_goal_fn, neighbor_weight_fn and is_goal are called
+/// concurrently by the workers, so they have to be thread safe.
+/// Nodes can be expanded out of order, so they are always reopened when a cheaper
+/// path to them is found, regardless of the policy's ReopenPolicy.
+/// @tparam Policy search_policy<> that selects each worker's fringe and node storage
+/// @param num_threads Number of worker threads, 0 uses std::thread::hardware_concurrency()
+/// @param observer Receives the search's statistics, e.g. search_stats_observer.
+///			The workers' counts are reported after the search, from the calling thread.
+/// @return Whether a path was found. The shortest path (from the start node
+///			to a goal node) is written to out_it, and its cost to opt_out_path_cost.
+///			Unlike a_star_search(), opt_out_path_cost is left untouched when no path
+///			is found, the workers don't share a last expanded cost to report.
+template <	typename Policy = default_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename OutputIterator,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+bool hda_star_search(
+	NodeType	start_node,
+	ExpandFn	expand_fn,
+	CostFn	cost_to_goal_fn,
+	WeightFn	neighbor_weight_fn,
+	IsGoalFn is_goal,
+	OutputIterator out_it,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	unsigned int num_threads = 0,
+	Observer observer = Observer())
+{
+	using cost_t = cost_value_t<CostFn, NodeType>;
+	using worker_t = detail_::hda_worker<Policy, NodeType, CostFn, HashFn>;
+	using entry_ptr_t = typename worker_t::entry_ptr_t;
+
+	if (num_threads == 0)
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<std::unique_ptr<worker_t>> workers;
+	for (unsigned int i = 0 ; i < num_threads ; i++)
+	{
+		workers.push_back(std::make_unique<worker_t>());
+		workers.back()->outboxes.resize(num_threads);
+	}
+
+	detail_::hda_shared_state<cost_t> shared;
+	entry_ptr_t goal_entry = nullptr;
+
+	{
+		detail_::scoped_phase<Observer> phase(observer, SearchPhase::SEARCH);
+		observer.iteration_started();
+
+		// The start node's owner gets it as a batch, all the workers start out busy
+		shared.work.store(num_threads + 1);
+		workers[detail_::hda_owner(HashFn(), start_node, num_threads)]->inbox.push(
+			typename worker_t::batch_t{ typename worker_t::message{start_node, 0, nullptr, 0} });
+
+		auto run_worker = [&](size_t i)
+		{
+			detail_::hda_worker_loop<Policy, worker_t, ExpandFn, CostFn, WeightFn, IsGoalFn, HashFn>(
+				i, workers, shared, expand_fn, cost_to_goal_fn, neighbor_weight_fn, is_goal, max_cost);
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1 ; i < num_threads ; i++)
+			threads.emplace_back(run_worker, i);
+
+		run_worker(0);
+
+		for (std::thread& t : threads)
+			t.join();
+
+		size_t num_nodes = 0;
+		for (auto const& w : workers)
+		{
+			if (w->goal && (!goal_entry || w->goal->second.cost_to_node < goal_entry->second.cost_to_node))
+				goal_entry = w->goal;
+
+			observer.add_counts(w->stats);
+
+			num_nodes += w->nodes.size();
+		}
+
+		observer.memory_used(num_nodes, 0, num_nodes * sizeof(std::remove_pointer_t<entry_ptr_t>));
+	}
+
+	if (!goal_entry)
+		return false;
+
+	if (opt_out_path_cost)
+		*opt_out_path_cost = goal_entry->second.cost_to_node;
+
+	detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+
+	// The path's nodes are spread over the workers' node storage,
+	// which is still around until we return
+	std::vector<entry_ptr_t> path;
+	detail_::output_path(goal_entry, path, out_it);
+
+	return true;
+}
+
+} // namespace astar
+
+} // namespace cds
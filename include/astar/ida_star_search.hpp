@@ -15,9 +15,13 @@
 #include <astar/detail/node.hpp>
 #include <astar/detail/ida_search.hpp>
 #include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/path_summary.hpp>
+#include <astar/search_stats.hpp>
 #include <utility>
-#include <stack>
-#include <list>
+#include <vector>
+#include <optional>
+#include <type_traits>
 
 namespace cds
 {
@@ -25,66 +29,91 @@ namespace cds
 namespace astar
 {
 
-template <	typename NodeType,
+namespace detail_
+{
+
+/// Holds the nodes on the current IDA* path. Only searches that check
+/// the whole path for cycles need to look nodes up, so the others
+/// use a plain stack.
+template <typename Policy, typename NodeType, typename CostFn, typename HashFn>
+using ida_node_set_t = std::conditional_t<
+	Policy::cycle_check == CycleCheck::PATH,
+	typename Policy::node_storage::template type<NodeType, node_info<NodeType, CostFn>, HashFn>,
+	path_node_stack<NodeType, node_info<NodeType, CostFn>> >;
+
+/// Creates the transposition table selected by the policy
+template <typename Policy, typename NodeType, typename CostFn, typename HashFn>
+auto make_ida_transposition_table()
+{
+	using tt_policy_t = typename Policy::transposition_table;
+
+	if constexpr (std::is_same_v<tt_policy_t, no_transposition_table>)
+		return no_transposition_table();
+	else
+		return typename tt_policy_t::template type<NodeType, cost_value_t<CostFn, NodeType>, HashFn>(tt_policy_t::max_bytes);
+}
+
+/// IDA* iterative deepening loop. On success, path holds the
+/// node entries from the start node to the goal node.
+template <	typename Policy,
+				typename HashFn,
+				typename NodeType,
 				typename ExpandFn,
 				typename CostFn,
 				typename WeightFn,
 				typename IsGoalFn,
-				typename OutputIterator,
-				typename HashFn = std::hash<NodeType>	>
-bool ida_star_search(
-	NodeType start_node,
-	ExpandFn expand,
-	CostFn cost_to_goal_fn,
-	WeightFn neighbor_weight_fn,
-	IsGoalFn is_goal_fn,
-	OutputIterator out_it,
-	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
-	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max())
+				typename NodeSet,
+				typename Observer >
+bool ida_star_search_impl(
+	NodeSet& node_set,
+	std::vector<typename node_info<NodeType, CostFn>::entry_ptr_t>& path,
+	NodeType const& start_node,
+	ExpandFn& expand,
+	CostFn& cost_to_goal_fn,
+	WeightFn& neighbor_weight_fn,
+	IsGoalFn& is_goal_fn,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost,
+	cost_value_t<CostFn, NodeType> max_cost,
+	Observer& observer)
 {
 	using cost_t = cost_value_t<CostFn, NodeType>;
-	using node_info_t = detail_::node_info<NodeType, CostFn>;
-	using node_set_t = std::unordered_map<NodeType, node_info_t, HashFn>;
+	using node_info_t = node_info<NodeType, CostFn>;
+
+	scoped_phase<Observer> phase(observer, SearchPhase::SEARCH);
 
-	cost_t bound = cost_to_goal_fn(start_node);
+	cost_t const start_cost_to_goal = cost_to_goal_fn(start_node);
+	cost_t bound = start_cost_to_goal;
+
+	ida_frame_stack<NodeType, CostFn> frames;
+	auto tt = make_ida_transposition_table<Policy, NodeType, CostFn, HashFn>();
 
 	while (true)
 	{
-		node_set_t node_set;
-		std::stack<typename node_info_t::entry_ptr_t> path_stack;
+		observer.iteration_started();
+
+		node_set.clear();
+		path.clear();
 
-		typename node_set_t::iterator root_it;
-		std::tie(root_it, std::ignore) = 
-			node_set.emplace(std::make_pair(start_node, node_info_t(detail_::NodeSetType::CLOSED, 0.0)));
-		path_stack.push(&(*root_it));
+		typename node_info_t::entry_ptr_t root_it;
+		std::tie(root_it, std::ignore) = node_set.emplace(start_node, node_info_t(NodeSetType::CLOSED, 0));
+		path.push_back(root_it);
 
 		cost_t t = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max();
 		bool found = false;
 
-		std::tie(found, t) = detail_::ida_search<NodeType, CostFn, ExpandFn, WeightFn, IsGoalFn, HashFn>(
-				path_stack,
+		std::tie(found, t) = ida_search<Policy, NodeType, CostFn, ExpandFn, WeightFn, IsGoalFn, NodeSet, decltype(tt), Observer>(
+				path,
+				frames,
 				node_set,
+				tt,
 				cost_to_goal_fn, expand, neighbor_weight_fn,
-				is_goal_fn, bound, max_cost);
+				is_goal_fn, start_cost_to_goal, bound, max_cost, observer);
 
 		if (opt_out_path_cost)
 			*opt_out_path_cost = bound;
 
 		if (found)
-		{
-			std::list<NodeType> path;
-
-			while (!path_stack.empty())
-			{
-				NodeType n = path_stack.top()->first;
-				path.emplace_front(std::move(n));
-				path_stack.pop();
-			}
-
-			std::copy(path.begin(), path.end(), out_it);
-
 			return true;
-		}
 
 		if (t == std::numeric_limits<cost_value_t<CostFn, NodeType>>::max())
 			break;	// No path exists
@@ -98,6 +127,90 @@ bool ida_star_search(
 	return false;
 }
 
+} // namespace detail_
+
+/// Implicit graph IDA* search
+/// @tparam Policy ida_search_policy<> that selects the node storage implementation
+/// @param observer Receives the search's statistics, e.g. search_stats_observer
+template <	typename Policy = default_ida_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename OutputIterator,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+bool ida_star_search(
+	NodeType start_node,
+	ExpandFn expand,
+	CostFn cost_to_goal_fn,
+	WeightFn neighbor_weight_fn,
+	IsGoalFn is_goal_fn,
+	OutputIterator out_it,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	Observer observer = Observer())
+{
+	using node_info_t = detail_::node_info<NodeType, CostFn>;
+	using node_set_t = detail_::ida_node_set_t<Policy, NodeType, CostFn, HashFn>;
+
+	node_set_t node_set;
+	std::vector<typename node_info_t::entry_ptr_t> path;
+
+	if (!detail_::ida_star_search_impl<Policy, HashFn>(
+			node_set, path,
+			start_node, expand, cost_to_goal_fn, neighbor_weight_fn, is_goal_fn,
+			opt_out_path_cost, max_cost, observer))
+	{
+		return false;
+	}
+
+	detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+
+	for (auto const& e : path)
+		*out_it++ = e->first;
+
+	return true;
+}
+
+/// Same as ida_star_search(), but only returns the length and cost of the
+/// path, without copying the path's nodes.
+/// @return The path summary, or std::nullopt if no path was found
+template <	typename Policy = default_ida_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+std::optional<path_summary<cost_value_t<CostFn, NodeType>>> ida_star_path_summary(
+	NodeType start_node,
+	ExpandFn expand,
+	CostFn cost_to_goal_fn,
+	WeightFn neighbor_weight_fn,
+	IsGoalFn is_goal_fn,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	Observer observer = Observer())
+{
+	using node_info_t = detail_::node_info<NodeType, CostFn>;
+	using node_set_t = detail_::ida_node_set_t<Policy, NodeType, CostFn, HashFn>;
+
+	node_set_t node_set;
+	std::vector<typename node_info_t::entry_ptr_t> path;
+
+	if (!detail_::ida_star_search_impl<Policy, HashFn>(
+			node_set, path,
+			start_node, expand, cost_to_goal_fn, neighbor_weight_fn, is_goal_fn,
+			nullptr, max_cost, observer))
+	{
+		return std::nullopt;
+	}
+
+	return path_summary<cost_value_t<CostFn, NodeType>>{ path.size(), path.back()->second.cost_to_node };
+}
+
 }
 
 }
\ No newline at end of file
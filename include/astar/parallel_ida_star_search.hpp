@@ -0,0 +1,410 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Parallel IDA* search
+// Each iteration searches the tree down to a fixed split depth on the calling
+// thread, and turns the nodes at that depth into work items. The subtrees below
+// them are searched by worker threads, (with the same bound) that take work items
+// from their own queue, and steal from each other once it's empty.
+// The worker threads are started once, and reused for each iteration.
+
+#pragma once
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/ida_search.hpp>
+#include <astar/detail/thread_pool.hpp>
+#include <astar/ida_star_search.hpp>
+#include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/search_stats.hpp>
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <optional>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+namespace cds
+{
+
+namespace astar
+{
+
+namespace detail_
+{
+
+/// A subtree for a parallel IDA* worker to search: the path
+/// from the start node to the subtree's root, with the cost to
+/// each node, and the estimated cost to goal of the subtree's root.
+template <typename NodeType, typename Cost>
+struct ida_work_item
+{
+	std::vector< std::pair<NodeType, Cost> > path;
+	Cost cost_to_goal;
+};
+
+/// One queue of work item indices per worker. A worker takes items from the
+/// front of its own queue, (the most promising ones, in search order)
+/// and steals from the back of the other workers' queues.
+class work_stealing_queues
+{
+	struct queue
+	{
+		std::mutex mutex;
+		std::deque<size_t> items;
+	};
+
+	std::vector< std::unique_ptr<queue> > m_queues;
+
+public:
+	explicit work_stealing_queues(size_t num_workers)
+	{
+		for (size_t i = 0 ; i < num_workers ; i++)
+			m_queues.push_back(std::make_unique<queue>());
+	}
+
+	void push(size_t worker, size_t item)
+	{
+		std::lock_guard<std::mutex> lock(m_queues[worker]->mutex);
+		m_queues[worker]->items.push_back(item);
+	}
+
+	std::optional<size_t> pop(size_t worker)
+	{
+		for (size_t i = 0 ; i < m_queues.size() ; i++)
+		{
+			queue& q = *m_queues[(worker + i) % m_queues.size()];
+
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.items.empty())
+				continue;
+
+			size_t item;
+			if (i == 0)
+			{
+				item = q.items.front();
+				q.items.pop_front();
+			}
+			else
+			{
+				item = q.items.back();
+				q.items.pop_back();
+			}
+
+			return item;
+		}
+
+		return std::nullopt;
+	}
+};
+
+/// Depth-first search from the end of path, (the cost to goal of that node is cost_to_goal)
+/// down to split_depth. The nodes at that depth are added to items. Nodes over the bound
+/// update min, like they do in ida_search(), and so does the cycle check.
+/// The depth is small, so this doesn't mind recursing.
+/// @return Whether a goal node was found above split_depth, path is the path to it
+template <	typename Policy,
+				typename NodeType,
+				typename Cost,
+				typename CostFn,
+				typename ExpandFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename Observer >
+bool ida_split(
+	std::vector< std::pair<NodeType, Cost> >& path,
+	Cost cost_to_goal,
+	size_t split_depth,
+	Cost bound,
+	Cost max_cost,
+	CostFn& cost_to_goal_fn,
+	ExpandFn& expand,
+	WeightFn& neighbor_weight,
+	IsGoalFn& is_goal_fn,
+	std::vector< ida_work_item<NodeType, Cost> >& items,
+	Cost& min,
+	Observer& observer)
+{
+	NodeType const node = path.back().first;
+	Cost const cost_to_node = path.back().second;
+
+	Cost const f = cost_to_node + cost_to_goal;
+	if (f > bound || f > max_cost)
+	{
+		min = std::min(min, f);
+		return false;
+	}
+
+	if (is_goal_fn(node))
+		return true;
+
+	if (path.size() > split_depth)
+	{
+		items.push_back(ida_work_item<NodeType, Cost>{ path, cost_to_goal });
+		return false;
+	}
+
+	observer.node_expanded();
+
+	std::vector< std::pair<NodeType, Cost> > successors;
+	for (auto&& adj_node : expand(node))
+	{
+		Cost const adj_cost_to_goal = successor_cost_to_goal(cost_to_goal_fn, node, cost_to_goal, adj_node);
+		successors.emplace_back(std::forward<decltype(adj_node)>(adj_node), adj_cost_to_goal);
+	}
+
+	std::sort(successors.begin(), successors.end(),
+		[](auto const& s1, auto const& s2) { return s1.second < s2.second; });
+
+	for (auto const& [adj_node, adj_cost_to_goal] : successors)
+	{
+		if constexpr (Policy::cycle_check == CycleCheck::PATH)
+		{
+			if (std::any_of(path.begin(), path.end(), [&adj_node](auto const& p) { return p.first == adj_node; }))
+				continue;
+		}
+		else if constexpr (Policy::cycle_check == CycleCheck::PARENT)
+		{
+			if (path.size() > 1 && adj_node == path[path.size() - 2].first)
+				continue;
+		}
+
+		observer.node_generated();
+
+		path.emplace_back(adj_node, cost_to_node + neighbor_weight(node, adj_node));
+		if (ida_split<Policy>(path, adj_cost_to_goal, split_depth, bound, max_cost,
+				cost_to_goal_fn, expand, neighbor_weight, is_goal_fn, items, min, observer))
+		{
+			return true;
+		}
+
+		path.pop_back();
+	}
+
+	return false;
+}
+
+/// A parallel IDA* worker thread's search state, kept between iterations
+template <typename Policy, typename NodeType, typename CostFn, typename HashFn>
+struct ida_worker
+{
+	using node_info_t = node_info<NodeType, CostFn>;
+	using node_set_t = ida_node_set_t<Policy, NodeType, CostFn, HashFn>;
+	using tt_t = decltype(make_ida_transposition_table<Policy, NodeType, CostFn, HashFn>());
+
+	node_set_t node_set;
+	std::vector<typename node_info_t::entry_ptr_t> path;
+	ida_frame_stack<NodeType, CostFn> frames;
+	tt_t tt = make_ida_transposition_table<Policy, NodeType, CostFn, HashFn>();
+
+	search_stats stats;	// reported to the observer after the search
+	cost_value_t<CostFn, NodeType> min;
+};
+
+} // namespace detail_
+
+/// Implicit graph IDA* search, with each iteration run in parallel by num_threads worker threads.
+/// The search tree is split into subtrees at split_depth, and these are searched in parallel.
+/// As soon as any worker finds a goal node, the others stop: every goal node found in an
+/// iteration is on a shortest path, so the path is still optimal. (though it might not be
+/// the one that ida_star_search() returns, if there is more than one)
+/// expand, cost_to_goal_fn, neighbor_weight_fn and is_goal_fn are called
+/// concurrently by the workers, so they have to be thread safe.
+/// @tparam Policy ida_search_policy<> that selects the node storage, cycle check
+///			and transposition table. (each worker has its own transposition table)
+/// @param num_threads Number of worker threads, 0 uses std::thread::hardware_concurrency()
+/// @param split_depth Depth of the subtrees' roots
+/// @param observer Receives the search's statistics, e.g. search_stats_observer.
+///			The workers' counts are reported after the search, from the calling thread.
+template <	typename Policy = default_ida_search_policy,
+				typename NodeType,
+				typename ExpandFn,
+				typename CostFn,
+				typename WeightFn,
+				typename IsGoalFn,
+				typename OutputIterator,
+				typename HashFn = std::hash<NodeType>,
+				typename Observer = null_search_observer >
+bool parallel_ida_star_search(
+	NodeType start_node,
+	ExpandFn expand,
+	CostFn cost_to_goal_fn,
+	WeightFn neighbor_weight_fn,
+	IsGoalFn is_goal_fn,
+	OutputIterator out_it,
+	cost_value_t<CostFn, NodeType>* opt_out_path_cost = nullptr,
+	cost_value_t<CostFn, NodeType> max_cost = std::numeric_limits<cost_value_t<CostFn, NodeType>>::max(),
+	unsigned int num_threads = 0,
+	size_t split_depth = 8,
+	Observer observer = Observer())
+{
+	using cost_t = cost_value_t<CostFn, NodeType>;
+	using node_info_t = detail_::node_info<NodeType, CostFn>;
+	using worker_t = detail_::ida_worker<Policy, NodeType, CostFn, HashFn>;
+	using work_item_t = detail_::ida_work_item<NodeType, cost_t>;
+
+	if (num_threads == 0)
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector< std::unique_ptr<worker_t> > workers;
+	for (unsigned int i = 0 ; i < num_threads ; i++)
+		workers.push_back(std::make_unique<worker_t>());
+
+	// Path to the goal node, if it's found above the split depth
+	std::vector< std::pair<NodeType, cost_t> > split_path;
+	worker_t const* goal_worker = nullptr;
+
+	auto report_workers = [&workers, &observer]
+	{
+		size_t num_nodes = 0;
+		size_t bytes = 0;
+		for (auto const& w : workers)
+		{
+			observer.add_counts(w->stats);
+			num_nodes += w->stats.peak_num_nodes;
+			bytes += w->stats.peak_memory;
+		}
+
+		observer.memory_used(num_nodes, 0, bytes);
+	};
+
+	{
+		detail_::scoped_phase<Observer> phase(observer, SearchPhase::SEARCH);
+
+		cost_t const start_cost_to_goal = cost_to_goal_fn(start_node);
+		cost_t bound = start_cost_to_goal;
+
+		std::vector<work_item_t> items;
+		std::optional<detail_::thread_pool> pool;
+
+		while (true)
+		{
+			observer.iteration_started();
+
+			items.clear();
+			split_path.assign(1, std::make_pair(start_node, cost_t(0)));
+
+			cost_t min = std::numeric_limits<cost_t>::max();
+			if (detail_::ida_split<Policy>(split_path, start_cost_to_goal, split_depth, bound, max_cost,
+					cost_to_goal_fn, expand, neighbor_weight_fn, is_goal_fn, items, min, observer))
+			{
+				break;
+			}
+
+			split_path.clear();
+
+			// Hand out the items round robin, so every worker starts with the most promising ones
+			detail_::work_stealing_queues queues(num_threads);
+			for (size_t i = 0 ; i < items.size() ; i++)
+				queues.push(i % num_threads, i);
+
+			std::atomic<bool> found{false};
+
+			auto run_worker = [&](size_t worker_index)
+			{
+				worker_t& w = *workers[worker_index];
+				auto worker_observer = detail_::make_worker_observer<Observer>(w.stats);
+				w.min = std::numeric_limits<cost_t>::max();
+
+				while (auto item_index = queues.pop(worker_index))
+				{
+					work_item_t const& item = items[*item_index];
+
+					w.node_set.clear();
+					w.path.clear();
+					for (auto const& [node, cost_to_node] : item.path)
+					{
+						typename node_info_t::entry_ptr_t node_it;
+						std::tie(node_it, std::ignore) = w.node_set.emplace(node, node_info_t(detail_::NodeSetType::CLOSED, cost_to_node));
+						w.path.push_back(node_it);
+					}
+
+					auto const [item_found, t] = detail_::ida_search<Policy, NodeType, CostFn, ExpandFn, WeightFn, IsGoalFn,
+						typename worker_t::node_set_t, typename worker_t::tt_t, decltype(worker_observer)>(
+							w.path, w.frames, w.node_set, w.tt,
+							cost_to_goal_fn, expand, neighbor_weight_fn, is_goal_fn,
+							item.cost_to_goal, bound, max_cost, worker_observer, &found);
+
+					if (item_found)
+					{
+						// Only the first worker to find a goal node gets to keep its path
+						bool expected = false;
+						if (found.compare_exchange_strong(expected, true))
+							goal_worker = &w;
+
+						return;
+					}
+
+					if (found.load(std::memory_order_relaxed))
+						return;
+
+					w.min = std::min(w.min, t);
+				}
+			};
+
+			// Started on the first iteration that isn't solved above the split depth
+			if (!pool)
+				pool.emplace(num_threads);
+
+			pool->run(run_worker);
+
+			if (goal_worker)
+				break;
+
+			for (auto const& w : workers)
+				min = std::min(min, w->min);
+
+			if (opt_out_path_cost)
+				*opt_out_path_cost = bound;
+
+			if (min == std::numeric_limits<cost_t>::max() || min > max_cost)
+			{
+				report_workers();
+				return false;
+			}
+
+			bound = min;
+		}
+
+		report_workers();
+	}
+
+	detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+
+	if (goal_worker)
+	{
+		if (opt_out_path_cost)
+			*opt_out_path_cost = goal_worker->path.back()->second.cost_to_node;
+
+		for (auto const& e : goal_worker->path)
+			*out_it++ = e->first;
+	}
+	else
+	{
+		if (opt_out_path_cost)
+			*opt_out_path_cost = split_path.back().second;
+
+		for (auto const& p : split_path)
+			*out_it++ = p.first;
+	}
+
+	return true;
+}
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,134 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Reusable A* search state, for running many queries without
+// reallocating the fringe, node storage and path buffer each time.
+
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <functional>
+#include <optional>
+
+#include <astar/detail/node.hpp>
+#include <astar/detail/a_star_search.hpp>
+#include <astar/cost_value.hpp>
+#include <astar/search_policy.hpp>
+#include <astar/path_summary.hpp>
+#include <astar/search_stats.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+/// Default policy for search_context, arena node storage so that
+/// clearing the context doesn't free the node entries
+using context_search_policy = search_policy<binary_heap_fringe, ReopenPolicy::NEVER, arena_node_storage>;
+
+template <	typename NodeType,
+				typename CostFn,
+				typename HashFn = std::hash<NodeType>,
+				typename Policy = context_search_policy >
+class search_context
+{
+public:
+	using cost_t = cost_value_t<CostFn, NodeType>;
+
+private:
+	using node_info_t =			detail_::node_info<NodeType, CostFn>;
+	using node_collection_t =	typename Policy::node_storage::template type<NodeType, node_info_t, HashFn>;
+	using fringe_t =				typename Policy::fringe::template type<NodeType, CostFn>;
+
+	node_collection_t m_nodes;
+	fringe_t m_fringe;
+	std::vector<typename node_info_t::entry_ptr_t> m_path;
+
+public:
+	search_context() = default;
+
+	search_context(search_context const&) = delete;
+	search_context& operator=(search_context const&) = delete;
+
+	/// Same as a_star_search(), but reuses the storage from previous searches
+	template <	typename ExpandFn,
+					typename WeightFn,
+					typename IsGoalFn,
+					typename OutputIterator,
+					typename Observer = null_search_observer >
+	bool search(
+		NodeType	start_node,
+		ExpandFn	expand_fn,
+		CostFn	cost_to_goal_fn,
+		WeightFn	neighbor_weight_fn,
+		IsGoalFn is_goal,
+		OutputIterator out_it,
+		cost_t* opt_out_path_cost = nullptr,
+		cost_t max_cost = std::numeric_limits<cost_t>::max(),
+		Observer observer = Observer())
+	{
+		auto const goal_entry = detail_::a_star_search_impl<Policy>(
+			m_nodes, m_fringe,
+			start_node, expand_fn, cost_to_goal_fn, neighbor_weight_fn, is_goal,
+			opt_out_path_cost, max_cost, observer);
+
+		if (!goal_entry)
+			return false;
+
+		detail_::scoped_phase<Observer> phase(observer, SearchPhase::PATH);
+		detail_::output_path(goal_entry, m_path, out_it);
+
+		return true;
+	}
+
+	/// Same as a_star_path_summary(), but reuses the storage from previous searches
+	template <	typename ExpandFn,
+					typename WeightFn,
+					typename IsGoalFn,
+					typename Observer = null_search_observer >
+	std::optional<path_summary<cost_t>> search_summary(
+		NodeType	start_node,
+		ExpandFn	expand_fn,
+		CostFn	cost_to_goal_fn,
+		WeightFn	neighbor_weight_fn,
+		IsGoalFn is_goal,
+		cost_t max_cost = std::numeric_limits<cost_t>::max(),
+		Observer observer = Observer())
+	{
+		auto const goal_entry = detail_::a_star_search_impl<Policy>(
+			m_nodes, m_fringe,
+			start_node, expand_fn, cost_to_goal_fn, neighbor_weight_fn, is_goal,
+			nullptr, max_cost, observer);
+
+		if (!goal_entry)
+			return std::nullopt;
+
+		return path_summary<cost_t>{ detail_::path_length(goal_entry), goal_entry->second.cost_to_node };
+	}
+
+	/// Discards the results of the last search, but keeps the allocated storage
+	void clear()
+	{
+		m_nodes.clear();
+		m_fringe.clear();
+		m_path.clear();
+	}
+
+	/// Number of nodes discovered by the last search
+	size_t num_nodes() const { return m_nodes.size(); }
+};
+
+} // namespace astar
+
+} // namespace cds
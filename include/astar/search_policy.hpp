@@ -0,0 +1,165 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Compile-time policies for a_star_search and ida_star_search, e.g.
+//		a_star_search<search_policy<binary_heap_fringe, ReopenPolicy::ON_BETTER_COST>>(start, ...)
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <astar/detail/open_list.hpp>
+#include <astar/detail/node_map.hpp>
+#include <astar/detail/flat_node_map.hpp>
+#include <astar/detail/dense_node_map.hpp>
+#include <astar/detail/transposition_table.hpp>
+#include <astar/cost_value.hpp>
+
+namespace cds
+{
+
+namespace astar
+{
+
+/// Binary heap fringe, a node gets pushed again every time its cost improves
+struct lazy_fringe
+{
+	template <typename NodeType, typename CostFn>
+	using type = detail_::lazy_open_list<NodeType, CostFn>;
+};
+
+/// Indexed d-ary heap fringe with decrease-key, each node is in the fringe at most once
+template <size_t D = 4>
+struct d_ary_heap_fringe
+{
+	template <typename NodeType, typename CostFn>
+	using type = detail_::d_ary_heap_open_list<NodeType, CostFn, D>;
+};
+
+using binary_heap_fringe = d_ary_heap_fringe<2>;
+
+/// Bucket queue fringe, O(1) push and pop, ties are broken in favor of the larger g.
+/// Only used when the cost type is integral, otherwise falls back to the Fallback fringe.
+/// Meant for small, dense ranges of f and g, e.g. unit cost puzzles: it keeps a bucket
+/// for each f-value in the fringe's range, and each of those has one for every g in its
+/// range, so graphs with large edge weights should use a heap fringe instead.
+template <typename Fallback = binary_heap_fringe>
+struct bucket_fringe
+{
+	template <typename NodeType, typename CostFn>
+	using type = std::conditional_t<
+		std::is_integral_v<cost_value_t<CostFn, NodeType>>,
+		detail_::bucket_open_list<NodeType, CostFn>,
+		typename Fallback::template type<NodeType, CostFn> >;
+};
+
+/// std::unordered_map node storage
+struct std_node_storage
+{
+	template <typename NodeType, typename InfoType, typename HashFn>
+	using type = detail_::std_node_map<NodeType, InfoType, HashFn>;
+};
+
+/// std::unordered_map node storage allocated from a monotonic arena
+struct arena_node_storage
+{
+	template <typename NodeType, typename InfoType, typename HashFn>
+	using type = detail_::arena_node_map<NodeType, InfoType, HashFn>;
+};
+
+/// Open addressing (Robin Hood) node storage, entries are allocated from a monotonic arena
+struct flat_node_storage
+{
+	template <typename NodeType, typename InfoType, typename HashFn>
+	using type = detail_::flat_node_map<NodeType, InfoType, HashFn>;
+};
+
+/// Flat array node storage, for state spaces with a perfect hash (e.g. permutations,
+/// by their rank.) IndexFn is default constructed, and maps each node to a distinct
+/// index below IndexFn().size(). The array has a pointer for every index, so this is
+/// only for state spaces that fit in memory. The search's HashFn isn't used.
+template <typename IndexFn>
+struct dense_node_storage
+{
+	template <typename NodeType, typename InfoType, typename HashFn>
+	using type = detail_::dense_node_map<NodeType, InfoType, IndexFn>;
+};
+
+/// What to do when a shorter path to an already expanded (CLOSED) node is found.
+/// NEVER is fine for consistent heuristics, where the first expansion of a node
+/// is always along a shortest path. Inconsistent heuristics need ON_BETTER_COST
+/// to return optimal paths.
+enum class ReopenPolicy
+{
+	NEVER,
+	ON_BETTER_COST
+};
+
+template <	typename Fringe = lazy_fringe,
+				ReopenPolicy Reopen = ReopenPolicy::NEVER,
+				typename NodeStorage = std_node_storage >
+struct search_policy
+{
+	using fringe = Fringe;
+	using node_storage = NodeStorage;
+
+	static constexpr ReopenPolicy reopen = Reopen;
+};
+
+using default_search_policy = search_policy<>;
+
+/// How IDA* avoids revisiting nodes that are already on the current path.
+/// PATH checks every node on the path, using the policy's node storage.
+/// PARENT only skips the node's parent, and NONE doesn't check at all;
+/// these keep the path in a plain stack, without hashing any nodes.
+enum class CycleCheck
+{
+	PATH,
+	PARENT,
+	NONE
+};
+
+/// IDA* without a transposition table
+struct no_transposition_table
+{
+};
+
+/// Transposition table for IDA*, that keeps the cost to each node and its
+/// backed up f-cost across iterations, so that subtrees that are known to
+/// exceed the bound aren't searched again. Uses at most MaxBytes of memory.
+template <size_t MaxBytes = (size_t(1) << 24)>
+struct bounded_transposition_table
+{
+	template <typename NodeType, typename Cost, typename HashFn>
+	using type = detail_::transposition_table<NodeType, Cost, HashFn>;
+
+	static constexpr size_t max_bytes = MaxBytes;
+};
+
+/// Compile-time policies for ida_star_search
+template <	typename NodeStorage = std_node_storage,
+				CycleCheck Check = CycleCheck::PATH,
+				typename TranspositionTable = no_transposition_table >
+struct ida_search_policy
+{
+	using node_storage = NodeStorage;
+	using transposition_table = TranspositionTable;
+
+	static constexpr CycleCheck cycle_check = Check;
+};
+
+using default_ida_search_policy = ida_search_policy<>;
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,173 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Optional instrumentation for the search engines.
+// The engines report what they do to an observer; the default
+// null_search_observer does nothing, so it compiles away entirely.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+namespace cds
+{
+
+namespace astar
+{
+
+/// Parts of a search that are timed separately
+enum class SearchPhase
+{
+	SEARCH,	///< Finding the goal node
+	PATH		///< Writing the path to the output iterator
+};
+
+struct search_stats;
+
+/// Observer that ignores everything (the default)
+struct null_search_observer
+{
+	void begin_phase(SearchPhase) {}
+	void end_phase(SearchPhase) {}
+
+	void iteration_started() {}
+	void node_expanded() {}
+	void node_generated() {}
+	void node_reopened() {}
+	void stale_entry_skipped() {}
+	void memory_used(size_t /*num_nodes*/, size_t /*fringe_size*/, size_t /*bytes*/) {}
+
+	void add_counts(search_stats const&) {}
+};
+
+/// Counters collected by search_stats_observer
+struct search_stats
+{
+	size_t nodes_expanded = 0;		///< Nodes whose successors were generated
+	size_t nodes_generated = 0;		///< Successors added to (or updated in) the fringe or IDA* path
+	size_t nodes_reopened = 0;		///< CLOSED nodes that were reopened (ReopenPolicy::ON_BETTER_COST)
+	size_t stale_entries = 0;		///< Fringe entries skipped because the node was already expanded or improved
+	size_t iterations = 0;			///< IDA* iterations (1 for A*)
+
+	size_t peak_num_nodes = 0;		///< Most nodes stored at once (the IDA* path depth, for IDA*)
+	size_t peak_fringe_size = 0;	///< Most fringe entries at once (0 for IDA*)
+	size_t peak_memory = 0;			///< Most bytes used by nodes and fringe entries at once (not counting container overhead)
+
+	std::chrono::nanoseconds search_time{0};
+	std::chrono::nanoseconds path_time{0};
+};
+
+/// Observer that records search_stats. Pass it to a search by value,
+/// the stats are written to the search_stats it was created with.
+class search_stats_observer
+{
+	using clock_t = std::chrono::steady_clock;
+
+	search_stats* m_stats;
+	clock_t::time_point m_phase_start;
+
+public:
+	explicit search_stats_observer(search_stats& stats)
+		: m_stats(&stats)
+	{
+
+	}
+
+	void begin_phase(SearchPhase)
+	{
+		m_phase_start = clock_t::now();
+	}
+
+	void end_phase(SearchPhase phase)
+	{
+		auto const elapsed = clock_t::now() - m_phase_start;
+		if (phase == SearchPhase::SEARCH)
+			m_stats->search_time += elapsed;
+		else
+			m_stats->path_time += elapsed;
+	}
+
+	void iteration_started() { m_stats->iterations++; }
+	void node_expanded() { m_stats->nodes_expanded++; }
+	void node_generated() { m_stats->nodes_generated++; }
+	void node_reopened() { m_stats->nodes_reopened++; }
+	void stale_entry_skipped() { m_stats->stale_entries++; }
+
+	/// Adds counts that were collected separately, (e.g. by a worker thread)
+	/// as if they had been observed one by one. Doesn't add iterations or times.
+	void add_counts(search_stats const& stats)
+	{
+		m_stats->nodes_expanded += stats.nodes_expanded;
+		m_stats->nodes_generated += stats.nodes_generated;
+		m_stats->nodes_reopened += stats.nodes_reopened;
+		m_stats->stale_entries += stats.stale_entries;
+	}
+
+	void memory_used(size_t num_nodes, size_t fringe_size, size_t bytes)
+	{
+		m_stats->peak_num_nodes = std::max(m_stats->peak_num_nodes, num_nodes);
+		m_stats->peak_fringe_size = std::max(m_stats->peak_fringe_size, fringe_size);
+		m_stats->peak_memory = std::max(m_stats->peak_memory, bytes);
+	}
+};
+
+namespace detail_
+{
+
+/// Times a search phase, for as long as it's in scope
+template <typename Observer>
+class scoped_phase
+{
+	Observer& m_observer;
+	SearchPhase m_phase;
+
+public:
+	scoped_phase(Observer& observer, SearchPhase phase)
+		: m_observer(observer)
+		, m_phase(phase)
+	{
+		m_observer.begin_phase(m_phase);
+	}
+
+	~scoped_phase()
+	{
+		m_observer.end_phase(m_phase);
+	}
+
+	scoped_phase(scoped_phase const&) = delete;
+	scoped_phase& operator=(scoped_phase const&) = delete;
+};
+
+/// Observer for a worker thread, that collects the counts to report to a search's
+/// observer afterwards, (with add_counts()) or nothing if it's a null_search_observer
+template <typename Observer>
+auto make_worker_observer(search_stats& stats)
+{
+	if constexpr (std::is_same_v<Observer, null_search_observer>)
+	{
+		(void)stats;
+		return null_search_observer();
+	}
+	else
+	{
+		return search_stats_observer(stats);
+	}
+}
+
+} // namespace detail_
+
+} // namespace astar
+
+} // namespace cds
@@ -0,0 +1,148 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/batch_search.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <vector>
+#include <utility>
+#include <iterator>
+
+using namespace cds;
+
+namespace
+{
+	using puzzle_query_t = std::pair<n_sq_puzzle<3>, n_sq_puzzle<3>>;
+
+	// Shuffled starts, and every other query has a shuffled goal instead of the solved puzzle
+	std::vector<puzzle_query_t> puzzle_queries(size_t num_queries)
+	{
+		std::vector<puzzle_query_t> queries(num_queries);
+		for (size_t i = 0 ; i < queries.size() ; i++)
+		{
+			queries[i].first.shuffle(static_cast<unsigned int>(i + 1));
+			if (i % 2 == 1)
+				queries[i].second.shuffle(static_cast<unsigned int>(i + 1000));
+		}
+
+		return queries;
+	}
+
+	auto const unit_weight = [](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); };
+
+	// Directed chain, 0 -> 1 -> ... -> 9
+	std::vector<int> expand_chain(int n)
+	{
+		return n < 9 ? std::vector<int>{ n + 1 } : std::vector<int>();
+	}
+}
+
+TEST(BatchSearchTest, SameResultsAsAStarSearchInInputOrder)
+{
+	auto const queries = puzzle_queries(24);
+
+	for (unsigned int num_threads : { 1u, 3u })
+	{
+		auto const results = astar::batch_search(
+			queries.begin(), queries.end(), &expand<3>, &tile_taxicab_dist<3>, unit_weight, num_threads);
+
+		ASSERT_EQ(results.size(), queries.size());
+
+		for (size_t i = 0 ; i < queries.size() ; i++)
+		{
+			auto const& [start, goal] = queries[i];
+
+			std::vector<n_sq_puzzle<3>> expected_path;
+			size_t expected_cost = 0;
+			bool const expected_found = astar::a_star_search(
+				start, &expand<3>,
+				[&goal = goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+				unit_weight,
+				[&goal = goal](n_sq_puzzle<3> const& p) { return p == goal; },
+				std::back_inserter(expected_path), &expected_cost);
+
+			ASSERT_EQ(results[i].has_value(), expected_found) << "query " << i;
+			if (!expected_found)
+				continue;
+
+			EXPECT_EQ(results[i]->cost, expected_cost) << "query " << i;
+			EXPECT_EQ(results[i]->path.size(), expected_cost + 1) << "query " << i;
+			EXPECT_EQ(results[i]->path.front(), start) << "query " << i;
+			EXPECT_EQ(results[i]->path.back(), goal) << "query " << i;
+		}
+	}
+}
+
+TEST(BatchSearchTest, NoPath)
+{
+	std::vector<std::pair<int, int>> const queries = { {0, 9}, {9, 0}, {3, 3}, {5, 2}, {2, 5} };
+
+	auto const results = astar::batch_search(
+		queries.begin(), queries.end(), &expand_chain,
+		[](int, int) { return 0; },
+		[](int, int) { return 1; },
+		2);
+
+	ASSERT_EQ(results.size(), queries.size());
+
+	ASSERT_TRUE(results[0].has_value());
+	EXPECT_EQ(results[0]->cost, 9);
+	EXPECT_EQ(results[0]->path.size(), 10u);
+
+	EXPECT_FALSE(results[1].has_value());
+
+	ASSERT_TRUE(results[2].has_value());
+	EXPECT_EQ(results[2]->path, std::vector<int>{3});
+	EXPECT_EQ(results[2]->cost, 0);
+
+	EXPECT_FALSE(results[3].has_value());
+
+	ASSERT_TRUE(results[4].has_value());
+	EXPECT_EQ(results[4]->path, (std::vector<int>{2, 3, 4, 5}));
+}
+
+TEST(BatchSearchTest, ReusesSearcherBetweenBatches)
+{
+	using heuristic_t = int (*)(int, int);
+	astar::batch_searcher<int, heuristic_t> searcher(4);
+	EXPECT_EQ(searcher.num_threads(), 4u);
+
+	heuristic_t const zero = [](int, int) { return 0; };
+	auto const weight = [](int, int) { return 1; };
+
+	std::vector<std::pair<int, int>> const no_queries;
+	EXPECT_TRUE(searcher.search(no_queries.begin(), no_queries.end(), &expand_chain, zero, weight).empty());
+
+	for (int batch = 0 ; batch < 8 ; batch++)
+	{
+		std::vector<std::pair<int, int>> queries;
+		for (int start = 0 ; start < 10 ; start++)
+			queries.emplace_back(start, 9 - batch);
+
+		auto const results = searcher.search(queries.begin(), queries.end(), &expand_chain, zero, weight);
+		ASSERT_EQ(results.size(), queries.size());
+
+		for (int start = 0 ; start < 10 ; start++)
+		{
+			ASSERT_EQ(results[start].has_value(), start <= 9 - batch) << "batch " << batch << ", start " << start;
+			if (results[start])
+			{
+				EXPECT_EQ(results[start]->cost, 9 - batch - start);
+			}
+		}
+	}
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/bidirectional_a_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <vector>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+
+#include "get_path_cost.h"
+
+using namespace cds;
+
+namespace
+{
+	constexpr int theGridDim = 32;
+
+	// 4-connected grid with random obstacles, and edge weights that
+	// depend on the direction of the edge
+	struct directed_grid
+	{
+		std::vector<bool> obstacles;
+
+		explicit directed_grid(unsigned int seed)
+			: obstacles(theGridDim * theGridDim)
+		{
+			std::mt19937 gen(seed);
+			std::uniform_real_distribution<double> dist(0.0, 1.0);
+			for (size_t i = 0 ; i < obstacles.size() ; i++)
+				obstacles[i] = dist(gen) < 0.25;
+		}
+
+		std::vector<int> expand(int n) const
+		{
+			std::vector<int> neighbors;
+			int const x = n % theGridDim;
+			int const y = n / theGridDim;
+
+			auto add = [this, &neighbors](int m) { if (!obstacles[m]) neighbors.push_back(m); };
+			if (x > 0) add(n - 1);
+			if (x < theGridDim - 1) add(n + 1);
+			if (y > 0) add(n - theGridDim);
+			if (y < theGridDim - 1) add(n + theGridDim);
+
+			return neighbors;
+		}
+
+		static int weight(int n, int m)
+		{
+			return 1 + (n * 31 + m) % 9;
+		}
+
+		static int manhattan_dist(int n, int m)
+		{
+			return std::abs(n % theGridDim - m % theGridDim) + std::abs(n / theGridDim - m / theGridDim);
+		}
+	};
+}
+
+TEST(BidirectionalAStarTest, SameCostAsAStarSearch)
+{
+	for (unsigned int seed = 1 ; seed <= 8 ; seed++)
+	{
+		directed_grid grid(seed);
+
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<int> random_node(0, theGridDim * theGridDim - 1);
+
+		for (int q = 0 ; q < 8 ; q++)
+		{
+			int const start = random_node(gen);
+			int const goal = random_node(gen);
+			grid.obstacles[start] = false;
+			grid.obstacles[goal] = false;
+
+			auto expand = [&grid](int n) { return grid.expand(n); };
+
+			std::vector<int> expected_path;
+			int expected_cost = 0;
+			bool const expected_found = astar::a_star_search(
+				start, expand,
+				[goal](int n) { return directed_grid::manhattan_dist(n, goal); },
+				&directed_grid::weight,
+				[goal](int n) { return n == goal; },
+				std::back_inserter(expected_path), &expected_cost);
+
+			std::vector<int> path;
+			int cost = 0;
+			bool const found = astar::bidirectional_a_star_search(
+				start, goal, expand, expand,
+				[goal](int n) { return directed_grid::manhattan_dist(n, goal); },
+				[start](int n) { return directed_grid::manhattan_dist(n, start); },
+				&directed_grid::weight,
+				std::back_inserter(path), &cost);
+
+			ASSERT_EQ(found, expected_found) << "seed " << seed << ", " << start << " -> " << goal;
+			if (!found)
+			{
+				EXPECT_TRUE(path.empty());
+				continue;
+			}
+
+			EXPECT_EQ(cost, expected_cost) << "seed " << seed << ", " << start << " -> " << goal;
+			EXPECT_EQ(get_path_cost(path.begin(), path.end(), &directed_grid::weight), cost);
+			EXPECT_EQ(path.front(), start);
+			EXPECT_EQ(path.back(), goal);
+
+			for (size_t i = 1 ; i < path.size() ; i++)
+				EXPECT_EQ(directed_grid::manhattan_dist(path[i - 1], path[i]), 1);
+		}
+	}
+}
+
+TEST(BidirectionalAStarTest, StartIsGoal)
+{
+	directed_grid const grid(1);
+	auto expand = [&grid](int n) { return grid.expand(n); };
+	auto zero = [](int) { return 0; };
+
+	std::vector<int> path;
+	int cost = -1;
+	ASSERT_TRUE(astar::bidirectional_a_star_search(
+		0, 0, expand, expand, zero, zero, &directed_grid::weight,
+		std::back_inserter(path), &cost));
+
+	EXPECT_EQ(path, std::vector<int>{0});
+	EXPECT_EQ(cost, 0);
+}
+
+TEST(BidirectionalAStarTest, ExpandsFewerNodes)
+{
+	// Open grid, so both searches meet in the middle
+	directed_grid grid(1);
+	std::fill(grid.obstacles.begin(), grid.obstacles.end(), false);
+
+	int const start = 0;
+	int const goal = theGridDim * theGridDim - 1;
+	auto expand = [&grid](int n) { return grid.expand(n); };
+	auto zero = [](int) { return 0; };
+
+	astar::search_stats a_star_stats;
+	std::vector<int> a_star_path;
+	ASSERT_TRUE(astar::a_star_search(
+		start, expand, zero, &directed_grid::weight,
+		[goal](int n) { return n == goal; },
+		std::back_inserter(a_star_path), nullptr,
+		std::numeric_limits<int>::max(), astar::search_stats_observer(a_star_stats)));
+
+	astar::search_stats bidir_stats;
+	std::vector<int> bidir_path;
+	ASSERT_TRUE(astar::bidirectional_a_star_search(
+		start, goal, expand, expand, zero, zero, &directed_grid::weight,
+		std::back_inserter(bidir_path), nullptr,
+		std::numeric_limits<int>::max(), astar::search_stats_observer(bidir_stats)));
+
+	EXPECT_LT(bidir_stats.nodes_expanded, a_star_stats.nodes_expanded);
+}
@@ -0,0 +1,188 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/breadth_first_search.hpp>
+#include <astar/ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <puzzle_heuristics.hpp>
+#include <pattern_database.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace cds;
+
+namespace
+{
+	constexpr int theGridDim = 16;
+
+	// 4-connected grid, with a wall down the middle that has a gap in the first row
+	std::vector<int> expand_grid_cell(int n)
+	{
+		std::vector<int> neighbors;
+		int const x = n % theGridDim;
+		int const y = n / theGridDim;
+
+		auto is_open = [](int x, int y) { return x != theGridDim / 2 || y == 0; };
+		auto add = [&](int x, int y) { if (is_open(x, y)) neighbors.push_back(y * theGridDim + x); };
+		if (x > 0) add(x - 1, y);
+		if (x < theGridDim - 1) add(x + 1, y);
+		if (y > 0) add(x, y - 1);
+		if (y < theGridDim - 1) add(x, y + 1);
+
+		return neighbors;
+	}
+
+	template <size_t N>
+	std::vector<uint8_t> puzzle_distance_table(unsigned int num_threads)
+	{
+		return astar::breadth_first_distance_table(
+			n_sq_puzzle<N>(), n_sq_puzzle<N>::num_states(), &expand<N>,
+			[](n_sq_puzzle<N> const& p) { return p.rank(); },
+			&n_sq_puzzle<N>::unrank,
+			num_threads);
+	}
+
+	std::vector<uint8_t> const& the_3x3_distance_table()
+	{
+		static std::vector<uint8_t> const distances = puzzle_distance_table<3>(2);
+		return distances;
+	}
+}
+
+TEST(BreadthFirstSearchTest, GridDistances)
+{
+	auto identity = [](int n) { return static_cast<size_t>(n); };
+	auto to_cell = [](size_t r) { return static_cast<int>(r); };
+
+	for (unsigned int num_threads : { 1u, 4u })
+	{
+		std::vector<uint8_t> const distances = astar::breadth_first_distance_table(
+			0, theGridDim * theGridDim, &expand_grid_cell, identity, to_cell, num_threads);
+
+		for (int y = 0 ; y < theGridDim ; y++)
+		{
+			for (int x = 0 ; x < theGridDim ; x++)
+			{
+				uint8_t const d = distances[y * theGridDim + x];
+				if (x == theGridDim / 2 && y != 0)
+					EXPECT_EQ(d, astar::unreachable_distance) << x << ", " << y;
+				else	// Cells right of the wall are reached through the gap at the top
+					EXPECT_EQ(d, x + y) << x << ", " << y;
+			}
+		}
+	}
+}
+
+TEST(BreadthFirstSearchTest, LayerSizes)
+{
+	auto identity = [](int n) { return static_cast<size_t>(n); };
+	auto to_cell = [](size_t r) { return static_cast<int>(r); };
+
+	std::vector<size_t> visited(theGridDim * theGridDim, 0);
+	std::vector<size_t> const layer_sizes = astar::breadth_first_layers(
+		0, theGridDim * theGridDim, &expand_grid_cell, identity, to_cell,
+		[&visited](size_t r, size_t) { visited[r]++; }, 2);
+
+	// Every cell but the wall, once
+	size_t const num_open = theGridDim * theGridDim - (theGridDim - 1);
+	EXPECT_EQ(std::accumulate(layer_sizes.begin(), layer_sizes.end(), size_t(0)), num_open);
+	EXPECT_EQ(std::accumulate(visited.begin(), visited.end(), size_t(0)), num_open);
+	EXPECT_EQ(*std::max_element(visited.begin(), visited.end()), 1);
+
+	ASSERT_EQ(layer_sizes.size(), 2 * (theGridDim - 1) + 1);
+	EXPECT_EQ(layer_sizes[0], 1);
+	EXPECT_EQ(layer_sizes[1], 2);
+}
+
+TEST(BreadthFirstSearchTest, Puzzle2x2)
+{
+	// The 12 states are in a cycle
+	std::vector<uint8_t> const distances = puzzle_distance_table<2>(1);
+	EXPECT_EQ(distances.size(), 12);
+	EXPECT_EQ(*std::max_element(distances.begin(), distances.end()), 6);
+	EXPECT_EQ(std::count(distances.begin(), distances.end(), astar::unreachable_distance), 0);
+}
+
+TEST(BreadthFirstSearchTest, Puzzle3x3)
+{
+	std::vector<uint8_t> const& distances = the_3x3_distance_table();
+
+	// Number of 8-puzzle states at each distance from the goal
+	std::vector<size_t> const expected_layer_sizes = {
+		1, 2, 4, 8, 16, 20, 39, 62, 116, 152, 286, 396, 748, 1024, 1893, 2512, 4485, 5638, 9529,
+		10878, 16993, 17110, 23952, 20224, 24047, 15578, 14560, 6274, 3910, 760, 221, 2 };
+
+	std::vector<size_t> layer_sizes(expected_layer_sizes.size(), 0);
+	for (uint8_t d : distances)
+	{
+		ASSERT_LT(d, layer_sizes.size());
+		layer_sizes[d]++;
+	}
+
+	EXPECT_EQ(layer_sizes, expected_layer_sizes);
+
+	// Same table, with any number of threads
+	EXPECT_EQ(puzzle_distance_table<3>(1), distances);
+	EXPECT_EQ(puzzle_distance_table<3>(4), distances);
+}
+
+TEST(BreadthFirstSearchTest, Puzzle3x3HeuristicsAreAdmissible)
+{
+	std::vector<uint8_t> const& distances = the_3x3_distance_table();
+
+	taxicab_heuristic<3> const taxicab;
+	linear_conflict_heuristic<3> const linear_conflict;
+	walking_distance_heuristic<3> const walking_distance;
+	pattern_database<3> const pdb;
+
+	for (size_t r = 0 ; r < distances.size() ; r++)
+	{
+		n_sq_puzzle<3> const puz = n_sq_puzzle<3>::unrank(r);
+		size_t const d = distances[r];
+
+		ASSERT_LE(taxicab(puz), d) << puz;
+		ASSERT_LE(linear_conflict(puz), d) << puz;
+		ASSERT_LE(walking_distance(puz), d) << puz;
+		ASSERT_LE(pdb(puz), d) << puz;
+	}
+}
+
+TEST(BreadthFirstSearchTest, Puzzle3x3DistanceHeuristic)
+{
+	std::vector<uint8_t> const& distances = the_3x3_distance_table();
+
+	n_sq_puzzle<3> puz;
+	puz.shuffle(1u);
+
+	// The exact distance only expands the nodes on a shortest path
+	astar::search_stats stats;
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 0;
+	ASSERT_TRUE(astar::ida_star_search(
+		puz, &expand<3>, [&distances](n_sq_puzzle<3> const& p) { return size_t(distances[p.rank()]); },
+		[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+		[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+		std::back_inserter(path), &cost,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats)));
+
+	EXPECT_EQ(cost, distances[puz.rank()]);
+	EXPECT_EQ(stats.nodes_expanded, cost);
+}
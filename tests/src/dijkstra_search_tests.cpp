@@ -16,6 +16,9 @@
 
 #include <astar/a_star_search.hpp>
 #include <astar/ida_star_search.hpp>
+#include <astar/bidirectional_a_star_search.hpp>
+#include <astar/hda_star_search.hpp>
+#include <astar/parallel_ida_star_search.hpp>
 
 #include <algorithm>
 #include <functional>
@@ -104,6 +107,7 @@ namespace
 	};
 }
 
+template <typename Policy = astar::default_search_policy>
 class AStarGraphSearchTest : public GraphSearchTest
 {
 public:
@@ -115,7 +119,7 @@ public:
 
 	bool doSearch(char start_node, std::vector<char>& out_path, int& out_path_cost)
 	{
-		return astar::a_star_search(
+		return astar::a_star_search<Policy>(
 			start_node,
 			[this](char n) { return this->expand(n); },
 			&null_heuristic,
@@ -127,6 +131,7 @@ public:
 	}
 };
 
+template <typename Policy = astar::default_ida_search_policy>
 class IDAStarGraphSearchTest : public GraphSearchTest
 {
 public:
@@ -138,7 +143,7 @@ public:
 
 	bool doSearch(char start_node, std::vector<char>& out_path, int& out_path_cost)
 	{
-		return astar::ida_star_search(
+		return astar::ida_star_search<Policy>(
 			start_node,
 			[this](char n) { return this->expand(n); },
 			&null_heuristic,
@@ -150,6 +155,86 @@ public:
 	}
 };
 
+template <typename Policy = astar::default_search_policy>
+class BidirectionalAStarGraphSearchTest : public GraphSearchTest
+{
+public:
+	BidirectionalAStarGraphSearchTest()
+		: GraphSearchTest(theGraph)
+	{
+
+	}
+
+	bool doSearch(char start_node, std::vector<char>& out_path, int& out_path_cost)
+	{
+		// The graph is undirected, so the predecessors of a node are its neighbors
+		return astar::bidirectional_a_star_search<Policy>(
+			start_node,
+			'z',
+			[this](char n) { return this->expand(n); },
+			[this](char n) { return this->expand(n); },
+			&null_heuristic,
+			&null_heuristic,
+			[this](char n, char m) { return this->neighbor_weight(n, m); },
+			std::back_inserter(out_path),
+			&out_path_cost
+		);
+	}
+};
+
+template <typename Policy = astar::default_search_policy, unsigned int NumThreads = 4>
+class HDAStarGraphSearchTest : public GraphSearchTest
+{
+public:
+	HDAStarGraphSearchTest()
+		: GraphSearchTest(theGraph)
+	{
+
+	}
+
+	bool doSearch(char start_node, std::vector<char>& out_path, int& out_path_cost)
+	{
+		return astar::hda_star_search<Policy>(
+			start_node,
+			[this](char n) { return this->expand(n); },
+			&null_heuristic,
+			[this](char n, char m) { return this->neighbor_weight(n, m); },
+			&is_goal,
+			std::back_inserter(out_path),
+			&out_path_cost,
+			std::numeric_limits<int>::max(),
+			NumThreads
+		);
+	}
+};
+
+template <typename Policy = astar::default_ida_search_policy, unsigned int NumThreads = 4>
+class ParallelIDAStarGraphSearchTest : public GraphSearchTest
+{
+public:
+	ParallelIDAStarGraphSearchTest()
+		: GraphSearchTest(theGraph)
+	{
+
+	}
+
+	bool doSearch(char start_node, std::vector<char>& out_path, int& out_path_cost)
+	{
+		return astar::parallel_ida_star_search<Policy>(
+			start_node,
+			[this](char n) { return this->expand(n); },
+			&null_heuristic,
+			[this](char n, char m) { return this->neighbor_weight(n, m); },
+			&is_goal,
+			std::back_inserter(out_path),
+			&out_path_cost,
+			std::numeric_limits<int>::max(),
+			NumThreads,
+			2
+		);
+	}
+};
+
 template <typename T>
 class DijkstraGraphSearchTest : public testing::Test
 {
@@ -158,7 +243,27 @@ protected:
 };
 
 using DijkstraGraphSearchImplementations = 
-	testing::Types<AStarGraphSearchTest, IDAStarGraphSearchTest>;
+	testing::Types<
+		AStarGraphSearchTest<>,
+		AStarGraphSearchTest<astar::search_policy<astar::binary_heap_fringe>>,
+		AStarGraphSearchTest<
+			astar::search_policy<astar::lazy_fringe, astar::ReopenPolicy::NEVER, astar::arena_node_storage>>,
+		AStarGraphSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		IDAStarGraphSearchTest<>,
+		IDAStarGraphSearchTest<astar::ida_search_policy<astar::flat_node_storage>>,
+		IDAStarGraphSearchTest<astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>>,
+		IDAStarGraphSearchTest<
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<4096>>>,
+		BidirectionalAStarGraphSearchTest<>,
+		BidirectionalAStarGraphSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		HDAStarGraphSearchTest<astar::default_search_policy, 1>,
+		HDAStarGraphSearchTest<>,
+		HDAStarGraphSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		ParallelIDAStarGraphSearchTest<>,
+		ParallelIDAStarGraphSearchTest<astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>>>;
 
 TYPED_TEST_SUITE(DijkstraGraphSearchTest, DijkstraGraphSearchImplementations);
 
@@ -0,0 +1,205 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/hda_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <algorithm>
+
+using namespace cds;
+
+namespace
+{
+	std::vector<n_sq_puzzle<3>> shuffled_puzzles(size_t num_puzzles)
+	{
+		std::vector<n_sq_puzzle<3>> puzzles(num_puzzles);
+		for (size_t i = 0 ; i < puzzles.size() ; i++)
+			puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+		return puzzles;
+	}
+
+	template <typename Policy = astar::default_search_policy, typename Observer = astar::null_search_observer>
+	bool solve_hda_star(
+		n_sq_puzzle<3> const& puz,
+		unsigned int num_threads,
+		std::vector<n_sq_puzzle<3>>& path,
+		size_t& cost,
+		Observer observer = Observer())
+	{
+		n_sq_puzzle<3> const goal;
+		return astar::hda_star_search<Policy>(
+			puz,
+			&expand<3>,
+			[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost,
+			std::numeric_limits<size_t>::max(), num_threads, observer);
+	}
+}
+
+TEST(HDAStarSearchTest, SameCostAsAStarSearch)
+{
+	n_sq_puzzle<3> const goal;
+
+	for (auto const& puz : shuffled_puzzles(8))
+	{
+		std::vector<n_sq_puzzle<3>> expected_path;
+		size_t expected_cost = 0;
+		ASSERT_TRUE(astar::a_star_search(
+			puz,
+			&expand<3>,
+			[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(expected_path), &expected_cost));
+
+		for (unsigned int num_threads : { 1u, 2u, 3u, 8u })
+		{
+			std::vector<n_sq_puzzle<3>> path;
+			size_t cost = 0;
+			ASSERT_TRUE(solve_hda_star(puz, num_threads, path, cost)) << num_threads << " threads";
+
+			EXPECT_EQ(cost, expected_cost) << num_threads << " threads";
+			ASSERT_EQ(path.size(), cost + 1);
+			EXPECT_EQ(path.front(), puz);
+			EXPECT_TRUE(path.back().is_solved());
+
+			for (size_t i = 1 ; i < path.size() ; i++)
+			{
+				auto const neighbors = expand<3>(path[i - 1]);
+				EXPECT_NE(std::find(neighbors.begin(), neighbors.end(), path[i]), neighbors.end());
+			}
+		}
+	}
+}
+
+TEST(HDAStarSearchTest, FlatNodeStorage)
+{
+	using policy_t = astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>;
+
+	for (auto const& puz : shuffled_puzzles(4))
+	{
+		std::vector<n_sq_puzzle<3>> path, expected_path;
+		size_t cost = 0, expected_cost = 0;
+		ASSERT_TRUE(solve_hda_star(puz, 1, expected_path, expected_cost));
+		ASSERT_TRUE(solve_hda_star<policy_t>(puz, 4, path, cost));
+		EXPECT_EQ(cost, expected_cost);
+	}
+}
+
+TEST(HDAStarSearchTest, IncrementalHeuristic)
+{
+	// The cost to goal of a node is computed from its parent's by the worker that owns the node
+	for (auto const& puz : shuffled_puzzles(4))
+	{
+		std::vector<n_sq_puzzle<3>> expected_path;
+		size_t expected_cost = 0;
+		ASSERT_TRUE(solve_hda_star(puz, 1, expected_path, expected_cost));
+
+		std::vector<n_sq_puzzle<3>> path;
+		size_t cost = 0;
+		ASSERT_TRUE(astar::hda_star_search(
+			puz,
+			&expand<3>,
+			taxicab_heuristic<3>(),
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost,
+			std::numeric_limits<size_t>::max(), 4));
+
+		EXPECT_EQ(cost, expected_cost);
+		EXPECT_EQ(path.size(), cost + 1);
+	}
+}
+
+TEST(HDAStarSearchTest, NoPath)
+{
+	// A chain of nodes that doesn't reach the goal, the workers have to agree that they're done
+	for (unsigned int num_threads : { 1u, 4u })
+	{
+		std::vector<int> path;
+		EXPECT_FALSE(astar::hda_star_search(
+			0,
+			[](int n) { return n < 1000 ? std::vector<int>{ n + 1 } : std::vector<int>(); },
+			[](int) { return 0; },
+			[](int, int) { return 1; },
+			[](int n) { return n == 2000; },
+			std::back_inserter(path), nullptr,
+			std::numeric_limits<int>::max(), num_threads));
+
+		EXPECT_TRUE(path.empty());
+	}
+}
+
+TEST(HDAStarSearchTest, MaxCost)
+{
+	auto const puz = shuffled_puzzles(1).front();
+
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 0;
+	ASSERT_TRUE(solve_hda_star(puz, 1, path, cost));
+
+	n_sq_puzzle<3> const goal;
+	std::vector<n_sq_puzzle<3>> capped_path;
+	EXPECT_FALSE(astar::hda_star_search(
+		puz,
+		&expand<3>,
+		[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+		[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+		[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+		std::back_inserter(capped_path), nullptr, cost - 1, 4));
+}
+
+TEST(HDAStarSearchTest, ReportsWorkerStats)
+{
+	auto const puz = shuffled_puzzles(1).front();
+
+	astar::search_stats single_stats;
+	std::vector<n_sq_puzzle<3>> single_path;
+	size_t single_cost = 0;
+	ASSERT_TRUE(solve_hda_star(puz, 1, single_path, single_cost, astar::search_stats_observer(single_stats)));
+
+	astar::search_stats stats;
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 0;
+	ASSERT_TRUE(solve_hda_star(puz, 4, path, cost, astar::search_stats_observer(stats)));
+
+	EXPECT_EQ(stats.iterations, 1u);
+	EXPECT_GT(stats.nodes_expanded, 0u);
+	EXPECT_GE(stats.nodes_generated, stats.nodes_expanded);
+
+	// Only one worker, so the nodes are expanded in the same order as A*
+	astar::search_stats a_star_stats;
+	n_sq_puzzle<3> const goal;
+	std::vector<n_sq_puzzle<3>> a_star_path;
+	ASSERT_TRUE(astar::a_star_search(
+		puz,
+		&expand<3>,
+		[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+		[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+		[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+		std::back_inserter(a_star_path), nullptr,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(a_star_stats)));
+
+	EXPECT_EQ(single_stats.nodes_expanded, a_star_stats.nodes_expanded);
+}
@@ -14,6 +14,11 @@
 
 #include <n_sq_puzzle.hpp>
 
+#include <algorithm>
+#include <vector>
+
+#include "random_walk.h"
+
 using namespace cds;
 
 template <typename T>
@@ -143,3 +148,166 @@ TYPED_TEST(NSqPuzzleTest, Move)
 		}
 	}
 }
+
+TYPED_TEST(NSqPuzzleTest, StateRoundTrip)
+{
+	constexpr size_t puzzle_dim = TestFixture::dim();
+
+	for (unsigned int seed = 1 ; seed <= 8 ; seed++)
+	{
+		TypeParam const puz = random_walk<TypeParam>(seed, 100);
+		auto const state = puz.get_state();
+
+		TypeParam other;
+		ASSERT_TRUE(other.set(state));
+		EXPECT_EQ(other, puz);
+		EXPECT_EQ(other.hash(), puz.hash());
+
+		for (size_t i = 0 ; i < puzzle_dim ; i++)
+		{
+			for (size_t j = 0 ; j < puzzle_dim ; j++)
+			{
+				EXPECT_EQ(puz(i, j), state[puzzle_dim * i + j]);
+				EXPECT_EQ(puz.get_ij_of(puz(i, j)), std::make_pair(i, j));
+			}
+		}
+	}
+}
+
+TYPED_TEST(NSqPuzzleTest, SetRejectsOutOfRangeTiles)
+{
+	constexpr int num_cells = static_cast<int>(TestFixture::dim() * TestFixture::dim());
+
+	TypeParam const solved;
+	for (int bad_tile : { -1, num_cells, num_cells + 1, 1000 })
+	{
+		auto state = solved.get_state();
+		state[0] = bad_tile;
+
+		TypeParam puz;
+		EXPECT_FALSE(puz.set(state)) << bad_tile;
+		EXPECT_EQ(puz, solved);
+	}
+}
+
+TYPED_TEST(NSqPuzzleTest, MoveAndBack)
+{
+	using MoveType = typename TestFixture::MoveType;
+
+	std::array<std::pair<MoveType, MoveType>, 4> const moves = { {
+		{ MoveType::UP, MoveType::DOWN },
+		{ MoveType::DOWN, MoveType::UP },
+		{ MoveType::LEFT, MoveType::RIGHT },
+		{ MoveType::RIGHT, MoveType::LEFT } } };
+
+	TypeParam const puz = random_walk<TypeParam>(1, 100);
+
+	for (auto const& [move, opposite] : moves)
+	{
+		if (!puz.can_move(move))
+			continue;
+
+		TypeParam const moved = puz.moved(move);
+		EXPECT_NE(moved, puz);
+		EXPECT_NE(moved.hash(), puz.hash());
+
+		TypeParam const back = moved.moved(opposite);
+		EXPECT_EQ(back, puz);
+		EXPECT_EQ(back.hash(), puz.hash());
+		EXPECT_EQ(back.get_state(), puz.get_state());
+	}
+}
+
+TYPED_TEST(NSqPuzzleTest, LexicographicOrder)
+{
+	std::vector<TypeParam> puzzles;
+	for (unsigned int seed = 1 ; seed <= 16 ; seed++)
+		puzzles.push_back(random_walk<TypeParam>(seed, 100));
+
+	for (auto const& p1 : puzzles)
+	{
+		EXPECT_FALSE(p1 < p1);
+
+		for (auto const& p2 : puzzles)
+			EXPECT_EQ(p1 < p2, p1.get_state() < p2.get_state());
+	}
+}
+
+TYPED_TEST(NSqPuzzleTest, DistinctHashes)
+{
+	std::vector<TypeParam> puzzles;
+	for (unsigned int seed = 1 ; seed <= 256 ; seed++)
+		puzzles.push_back(random_walk<TypeParam>(seed, 100));
+
+	std::sort(puzzles.begin(), puzzles.end());
+	puzzles.erase(std::unique(puzzles.begin(), puzzles.end()), puzzles.end());
+
+	std::vector<size_t> hashes;
+	for (auto const& puz : puzzles)
+		hashes.push_back(puz.hash());
+
+	std::sort(hashes.begin(), hashes.end());
+	EXPECT_EQ(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
+
+TEST(NSqPuzzlePackedTest, Size)
+{
+	// Puzzles up to 4x4 pack their tiles into a single word
+	EXPECT_LE(sizeof(n_sq_puzzle<3>), 2 * sizeof(uint64_t));
+	EXPECT_LE(sizeof(n_sq_puzzle<4>), 2 * sizeof(uint64_t));
+	EXPECT_GE(sizeof(n_sq_puzzle<5>), 25 * sizeof(int));
+}
+
+template <typename T>
+class NSqPuzzleRankTest : public testing::Test { };
+
+using NSqPuzzleRankTestImplementations = testing::Types<n_sq_puzzle<2>, n_sq_puzzle<3>>;
+
+TYPED_TEST_SUITE(NSqPuzzleRankTest, NSqPuzzleRankTestImplementations);
+
+TYPED_TEST(NSqPuzzleRankTest, RanksEveryStateOnce)
+{
+	using MoveType = typename TypeParam::MoveType;
+
+	// Breadth first search of all of the states, by rank
+	std::vector<bool> seen(TypeParam::num_states(), false);
+	std::vector<TypeParam> states{ TypeParam() };
+	seen[TypeParam().rank()] = true;
+
+	for (size_t s = 0 ; s < states.size() ; s++)
+	{
+		TypeParam const puz = states[s];
+		ASSERT_EQ(TypeParam::unrank(puz.rank()), puz);
+
+		for (MoveType m : { MoveType::UP, MoveType::DOWN, MoveType::LEFT, MoveType::RIGHT })
+		{
+			TypeParam next = puz;
+			if (!next.move(m))
+				continue;
+
+			size_t const r = next.rank();
+			ASSERT_LT(r, TypeParam::num_states());
+			if (!seen[r])
+			{
+				seen[r] = true;
+				states.push_back(next);
+			}
+		}
+	}
+
+	// No two states have the same rank, or there would be fewer of them
+	EXPECT_EQ(states.size(), TypeParam::num_states());
+}
+
+TEST(NSqPuzzleRankTest, RankAndUnrank4x4)
+{
+	EXPECT_EQ(n_sq_puzzle<4>::num_states(), 16 * 653837184000ull);
+	EXPECT_EQ(n_sq_puzzle<4>::unrank(n_sq_puzzle<4>().rank()), n_sq_puzzle<4>());
+
+	for (unsigned int seed = 1 ; seed <= 256 ; seed++)
+	{
+		auto const puz = random_walk<n_sq_puzzle<4>>(seed, 200);
+		ASSERT_LT(puz.rank(), n_sq_puzzle<4>::num_states());
+		EXPECT_EQ(n_sq_puzzle<4>::unrank(puz.rank()), puz) << puz;
+	}
+}
@@ -0,0 +1,275 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/search_policy.hpp>
+#include <astar/detail/node.hpp>
+#include <astar/detail/node_map.hpp>
+#include <astar/detail/node_arena.hpp>
+#include <astar/detail/dense_node_map.hpp>
+#include <astar/detail/transposition_table.hpp>
+
+#include <vector>
+
+using namespace cds;
+
+namespace
+{
+	int int_cost(int) { return 0; }
+
+	using int_node_info_t = astar::detail_::node_info<int, decltype(&int_cost)>;
+
+	// Perfect hash of the ints used by the tests
+	struct int_index
+	{
+		size_t size() const { return 1001; }
+		size_t operator()(int n) const { return static_cast<size_t>(n); }
+	};
+}
+
+template <typename NodeStorage>
+class NodeMapTest : public testing::Test
+{
+protected:
+	using node_map_t = typename NodeStorage::template type<int, int_node_info_t, std::hash<int>>;
+
+	node_map_t theMap;
+};
+
+using NodeMapTestImplementations =
+	testing::Types<astar::std_node_storage, astar::arena_node_storage, astar::flat_node_storage,
+		astar::dense_node_storage<int_index>>;
+
+TYPED_TEST_SUITE(NodeMapTest, NodeMapTestImplementations);
+
+TYPED_TEST(NodeMapTest, EmplaceFindErase)
+{
+	auto& nodes = this->theMap;
+	using astar::detail_::NodeSetType;
+
+	std::vector<typename int_node_info_t::entry_ptr_t> entries;
+	for (int i = 0 ; i < 1000 ; i++)
+	{
+		auto r = nodes.emplace(i, int_node_info_t(NodeSetType::OPEN, i * 2));
+		ASSERT_TRUE(r.second);
+		entries.push_back(r.first);
+	}
+
+	EXPECT_EQ(nodes.size(), 1000);
+	EXPECT_FALSE(nodes.emplace(10, int_node_info_t(NodeSetType::OPEN, 0)).second);
+
+	// Entries don't move when the map grows
+	for (int i = 0 ; i < 1000 ; i++)
+	{
+		auto e = nodes.find(i);
+		ASSERT_EQ(e, entries[i]);
+		EXPECT_EQ(e->first, i);
+		EXPECT_EQ(e->second.cost_to_node, i * 2);
+	}
+
+	EXPECT_EQ(nodes.find(1000), nullptr);
+
+	for (int i = 0 ; i < 1000 ; i += 2)
+		nodes.erase(nodes.find(i));
+
+	EXPECT_EQ(nodes.size(), 500);
+	for (int i = 0 ; i < 1000 ; i++)
+		EXPECT_EQ(nodes.find(i) != nullptr, i % 2 == 1) << i;
+
+	nodes.clear();
+	EXPECT_EQ(nodes.size(), 0);
+	EXPECT_EQ(nodes.find(1), nullptr);
+}
+
+TEST(NodeArenaTest, ResetReusesBlocks)
+{
+	using astar::detail_::NodeSetType;
+	astar::detail_::arena_node_map<int, int_node_info_t, std::hash<int>> nodes;
+
+	auto fill = [&nodes]
+	{
+		for (int i = 0 ; i < 10000 ; i++)
+			nodes.emplace(i, int_node_info_t(NodeSetType::OPEN, i));
+	};
+
+	fill();
+	size_t const capacity = nodes.arena().capacity();
+	EXPECT_GT(capacity, 0);
+
+	for (int i = 0 ; i < 3 ; i++)
+	{
+		nodes.clear();
+		fill();
+
+		EXPECT_EQ(nodes.size(), 10000);
+		EXPECT_EQ(nodes.arena().capacity(), capacity);
+	}
+}
+
+TEST(NodeArenaTest, EraseReusesMemory)
+{
+	using astar::detail_::NodeSetType;
+	astar::detail_::arena_node_map<int, int_node_info_t, std::hash<int>> nodes;
+
+	// Like an IDA* path check, every node is new, but only a few are stored at once
+	std::vector<typename int_node_info_t::entry_ptr_t> path;
+	int next_node = 0;
+	auto walk = [&nodes, &path, &next_node](int num_steps)
+	{
+		for (int i = 0 ; i < num_steps ; i++)
+		{
+			int const depth = i % 20;
+			while (path.size() > static_cast<size_t>(depth))
+			{
+				nodes.erase(path.back());
+				path.pop_back();
+			}
+
+			path.push_back(nodes.emplace(next_node++, int_node_info_t(NodeSetType::CLOSED, depth)).first);
+		}
+	};
+
+	walk(1000);
+	size_t const capacity = nodes.arena().capacity();
+
+	walk(100000);
+	EXPECT_LE(nodes.size(), 20);
+	EXPECT_EQ(nodes.arena().capacity(), capacity);
+}
+
+TEST(NodeArenaTest, MoveAssign)
+{
+	using astar::detail_::NodeSetType;
+	using arena_map_t = astar::detail_::arena_node_map<int, int_node_info_t, std::hash<int>>;
+
+	arena_map_t nodes;
+	for (int i = 0 ; i < 100 ; i++)
+		nodes.emplace(i, int_node_info_t(NodeSetType::OPEN, i));
+
+	arena_map_t other;
+	other.emplace(-1, int_node_info_t(NodeSetType::OPEN, 0));
+	other = std::move(nodes);
+
+	EXPECT_EQ(other.size(), 100);
+	EXPECT_EQ(other.find(-1), nullptr);
+	ASSERT_NE(other.find(42), nullptr);
+	EXPECT_EQ(other.find(42)->second.cost_to_node, 42);
+
+	other.clear();
+	EXPECT_EQ(other.size(), 0);
+	EXPECT_TRUE(other.emplace(1, int_node_info_t(NodeSetType::OPEN, 1)).second);
+}
+
+TEST(DenseNodeMapTest, EmplaceEraseStaysBounded)
+{
+	using astar::detail_::NodeSetType;
+	astar::detail_::dense_node_map<int, int_node_info_t, int_index> nodes;
+
+	// Like an IDA* path, that goes up and down over the same few nodes
+	std::vector<typename int_node_info_t::entry_ptr_t> path;
+	auto walk = [&nodes, &path](int num_steps)
+	{
+		for (int i = 0 ; i < num_steps ; i++)
+		{
+			int const depth = i % 20;
+			while (path.size() > static_cast<size_t>(depth))
+			{
+				nodes.erase(path.back());
+				path.pop_back();
+			}
+
+			path.push_back(nodes.emplace(depth + i % 7, int_node_info_t(NodeSetType::CLOSED, depth)).first);
+		}
+	};
+
+	walk(1000);
+	size_t const capacity = nodes.arena().capacity();
+	EXPECT_LE(nodes.num_used(), 26);
+
+	walk(100000);
+	EXPECT_LE(nodes.num_used(), 26);
+	EXPECT_EQ(nodes.arena().capacity(), capacity);
+	path.clear();
+
+	nodes.clear();
+	EXPECT_EQ(nodes.size(), 0);
+	EXPECT_EQ(nodes.num_used(), 0);
+
+	// Indices that were used before the clear() are recorded again
+	nodes.emplace(3, int_node_info_t(NodeSetType::OPEN, 0));
+	EXPECT_EQ(nodes.num_used(), 1);
+	nodes.clear();
+	EXPECT_EQ(nodes.find(3), nullptr);
+}
+
+TEST(TranspositionTableTest, StoreFindReplace)
+{
+	// Identity hash, so we know which nodes share a slot
+	struct int_hash { size_t operator()(int n) const { return static_cast<size_t>(n); } };
+
+	astar::detail_::transposition_table<int, int, int_hash> tt(1024);
+	EXPECT_GE(tt.capacity(), 1);
+	EXPECT_LE(tt.max_memory_size(), 1024);
+
+	EXPECT_EQ(tt.find(3), nullptr);
+
+	tt.store(3, 5, 12);
+	auto const* e = tt.find(3);
+	ASSERT_NE(e, nullptr);
+	EXPECT_EQ(e->cost_to_node, 5);
+	EXPECT_EQ(e->backed_up_cost, 12);
+
+	tt.store(3, 4, 13);
+	e = tt.find(3);
+	ASSERT_NE(e, nullptr);
+	EXPECT_EQ(e->cost_to_node, 4);
+	EXPECT_EQ(e->backed_up_cost, 13);
+
+	// Fill the table, so that 3 gets replaced
+	for (int i = 0 ; i < static_cast<int>(tt.max_capacity()) * 4 ; i++)
+		tt.store(i + 100, i, i);
+
+	EXPECT_EQ(tt.find(3), nullptr);
+	EXPECT_EQ(tt.capacity(), tt.max_capacity());
+	EXPECT_LE(tt.memory_size(), 1024);
+	EXPECT_LE(tt.size(), tt.capacity());
+
+	tt.clear();
+	EXPECT_EQ(tt.size(), 0);
+	EXPECT_EQ(tt.find(100), nullptr);
+}
+
+TEST(TranspositionTableTest, GrowsUpToBudget)
+{
+	astar::detail_::transposition_table<int, int> tt(size_t(1) << 20);
+	size_t const initial_capacity = tt.capacity();
+
+	for (int i = 0 ; i < static_cast<int>(initial_capacity) ; i++)
+		tt.store(i, i, i + 1);
+
+	EXPECT_GT(tt.capacity(), initial_capacity);
+	EXPECT_LE(tt.memory_size(), size_t(1) << 20);
+
+	// Entries are kept when the table grows (as long as they don't collide)
+	size_t num_found = 0;
+	for (int i = 0 ; i < static_cast<int>(initial_capacity) ; i++)
+		if (auto const* e = tt.find(i); e && e->backed_up_cost == i + 1)
+			num_found++;
+
+	EXPECT_EQ(num_found, tt.size());
+	EXPECT_GT(num_found, initial_capacity / 2);
+
+	// The last time the table grows, it holds the old slots and the new ones
+	EXPECT_GT(tt.max_capacity(), initial_capacity);
+	EXPECT_LE(tt.max_memory_size() + tt.max_memory_size() / 2, size_t(1) << 20);
+}
@@ -0,0 +1,253 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/ida_star_search.hpp>
+#include <astar/parallel_ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <algorithm>
+
+using namespace cds;
+
+namespace
+{
+	using parent_check_policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>;
+
+	std::vector<n_sq_puzzle<3>> shuffled_puzzles(size_t num_puzzles)
+	{
+		std::vector<n_sq_puzzle<3>> puzzles(num_puzzles);
+		for (size_t i = 0 ; i < puzzles.size() ; i++)
+			puzzles[i].shuffle(static_cast<unsigned int>(i + 1));
+
+		return puzzles;
+	}
+
+	template <typename Policy = parent_check_policy_t, typename Observer = astar::null_search_observer>
+	bool solve_parallel_ida_star(
+		n_sq_puzzle<3> const& puz,
+		unsigned int num_threads,
+		size_t split_depth,
+		std::vector<n_sq_puzzle<3>>& path,
+		size_t& cost,
+		size_t max_cost = std::numeric_limits<size_t>::max(),
+		Observer observer = Observer())
+	{
+		n_sq_puzzle<3> const goal;
+		return astar::parallel_ida_star_search<Policy>(
+			puz,
+			&expand<3>,
+			[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost,
+			max_cost, num_threads, split_depth, observer);
+	}
+
+	void expect_valid_path(std::vector<n_sq_puzzle<3>> const& path, n_sq_puzzle<3> const& start, size_t cost)
+	{
+		ASSERT_EQ(path.size(), cost + 1);
+		EXPECT_EQ(path.front(), start);
+		EXPECT_TRUE(path.back().is_solved());
+
+		for (size_t i = 1 ; i < path.size() ; i++)
+		{
+			auto const neighbors = expand<3>(path[i - 1]);
+			EXPECT_NE(std::find(neighbors.begin(), neighbors.end(), path[i]), neighbors.end());
+		}
+	}
+}
+
+TEST(ParallelIDAStarSearchTest, SameCostAsIDAStarSearch)
+{
+	n_sq_puzzle<3> const goal;
+
+	for (auto const& puz : shuffled_puzzles(6))
+	{
+		std::vector<n_sq_puzzle<3>> expected_path;
+		size_t expected_cost = 0;
+		ASSERT_TRUE(astar::ida_star_search<parent_check_policy_t>(
+			puz,
+			&expand<3>,
+			[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(expected_path), &expected_cost));
+
+		for (unsigned int num_threads : { 1u, 2u, 4u })
+		{
+			for (size_t split_depth : { 0u, 3u, 8u, 40u })
+			{
+				std::vector<n_sq_puzzle<3>> path;
+				size_t cost = 0;
+				ASSERT_TRUE(solve_parallel_ida_star(puz, num_threads, split_depth, path, cost))
+					<< num_threads << " threads, split depth " << split_depth;
+
+				EXPECT_EQ(cost, expected_cost) << num_threads << " threads, split depth " << split_depth;
+				expect_valid_path(path, puz, cost);
+			}
+		}
+	}
+}
+
+TEST(ParallelIDAStarSearchTest, PathCycleCheckAndTranspositionTable)
+{
+	using tt_policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<1 << 16>>;
+
+	for (auto const& puz : shuffled_puzzles(3))
+	{
+		std::vector<n_sq_puzzle<3>> expected_path, path;
+		size_t expected_cost = 0, cost = 0;
+		ASSERT_TRUE(solve_parallel_ida_star(puz, 1, 0, expected_path, expected_cost));
+		ASSERT_TRUE(solve_parallel_ida_star<tt_policy_t>(puz, 4, 6, path, cost));
+
+		EXPECT_EQ(cost, expected_cost);
+		expect_valid_path(path, puz, cost);
+	}
+}
+
+TEST(ParallelIDAStarSearchTest, TranspositionTableSameCostAsAStar)
+{
+	using path_tt_policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<>>;
+	using parent_tt_policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<1 << 20>>;
+
+	n_sq_puzzle<3> const goal;
+
+	for (size_t i = 0 ; i < 300 ; i++)
+	{
+		auto const puz = n_sq_puzzle<3>::unrank((i * 7919 * 13 + 12345) % 181440);
+
+		std::vector<n_sq_puzzle<3>> expected_path;
+		size_t expected_cost = 0;
+		ASSERT_TRUE(astar::a_star_search(
+			puz,
+			&expand<3>,
+			[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(expected_path), &expected_cost));
+
+		std::vector<n_sq_puzzle<3>> path;
+		size_t cost = 0;
+		ASSERT_TRUE(solve_parallel_ida_star<path_tt_policy_t>(puz, 4, 2, path, cost));
+		EXPECT_EQ(cost, expected_cost) << puz;
+		expect_valid_path(path, puz, cost);
+
+		path.clear();
+		ASSERT_TRUE(solve_parallel_ida_star<parent_tt_policy_t>(puz, 1, 0, path, cost));
+		EXPECT_EQ(cost, expected_cost) << puz;
+		expect_valid_path(path, puz, cost);
+	}
+}
+
+TEST(ParallelIDAStarSearchTest, StartIsGoal)
+{
+	n_sq_puzzle<3> const goal;
+
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 1;
+	ASSERT_TRUE(solve_parallel_ida_star(goal, 4, 8, path, cost));
+
+	EXPECT_EQ(path, std::vector<n_sq_puzzle<3>>{goal});
+	EXPECT_EQ(cost, 0u);
+}
+
+TEST(ParallelIDAStarSearchTest, MaxCost)
+{
+	auto const puz = shuffled_puzzles(1).front();
+
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 0;
+	ASSERT_TRUE(solve_parallel_ida_star(puz, 1, 0, path, cost));
+
+	std::vector<n_sq_puzzle<3>> capped_path;
+	size_t capped_cost = 0;
+	EXPECT_FALSE(solve_parallel_ida_star(puz, 4, 4, capped_path, capped_cost, cost - 1));
+	EXPECT_TRUE(capped_path.empty());
+}
+
+TEST(ParallelIDAStarSearchTest, NoPath)
+{
+	// A chain of nodes that doesn't reach the goal
+	std::vector<int> path;
+	EXPECT_FALSE(astar::parallel_ida_star_search(
+		0,
+		[](int n) { return n < 100 ? std::vector<int>{ n + 1 } : std::vector<int>(); },
+		[](int) { return 0; },
+		[](int, int) { return 1; },
+		[](int n) { return n == 200; },
+		std::back_inserter(path), nullptr,
+		std::numeric_limits<int>::max(), 4, 3));
+
+	EXPECT_TRUE(path.empty());
+}
+
+TEST(ParallelIDAStarSearchTest, ReportsWorkerStats)
+{
+	auto const puz = shuffled_puzzles(1).front();
+
+	// With no split, and one worker, the search is the same as ida_star_search()
+	astar::search_stats stats;
+	std::vector<n_sq_puzzle<3>> path;
+	size_t cost = 0;
+	ASSERT_TRUE(solve_parallel_ida_star(puz, 1, 0, path, cost,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats)));
+
+	n_sq_puzzle<3> const goal;
+	astar::search_stats expected_stats;
+	std::vector<n_sq_puzzle<3>> expected_path;
+	ASSERT_TRUE(astar::ida_star_search<parent_check_policy_t>(
+		puz,
+		&expand<3>,
+		[&goal](n_sq_puzzle<3> const& p) { return tile_taxicab_dist(p, goal); },
+		[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+		[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+		std::back_inserter(expected_path), nullptr,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(expected_stats)));
+
+	EXPECT_EQ(stats.iterations, expected_stats.iterations);
+	EXPECT_EQ(stats.nodes_expanded, expected_stats.nodes_expanded);
+	EXPECT_EQ(path, expected_path);
+}
+
+TEST(ParallelIDAStarSearchTest, IncrementalHeuristic)
+{
+	// The workers and the split compute the successors' cost to goal from their parent's
+	for (auto const& puz : shuffled_puzzles(4))
+	{
+		std::vector<n_sq_puzzle<3>> expected_path;
+		size_t expected_cost = 0;
+		ASSERT_TRUE(solve_parallel_ida_star(puz, 1, 0, expected_path, expected_cost));
+
+		std::vector<n_sq_puzzle<3>> path;
+		size_t cost = 0;
+		ASSERT_TRUE(astar::parallel_ida_star_search<parent_check_policy_t>(
+			puz,
+			&expand<3>,
+			taxicab_heuristic<3>(),
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost,
+			std::numeric_limits<size_t>::max(), 4, 4));
+
+		EXPECT_EQ(cost, expected_cost);
+		expect_valid_path(path, puz, cost);
+	}
+}
@@ -0,0 +1,223 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <pattern_database.hpp>
+
+#include <astar/a_star_search.hpp>
+#include <astar/ida_star_search.hpp>
+
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "random_walk.h"
+
+using namespace cds;
+
+namespace
+{
+	pattern_database<3> const& the_3x3_database()
+	{
+		static pattern_database<3> const pdb;
+		return pdb;
+	}
+
+	pattern_database<4> const& the_4x4_database()
+	{
+		static pattern_database<4> const pdb;
+		return pdb;
+	}
+
+	std::vector<char> read_file(std::string const& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	void write_file(std::string const& path, std::vector<char> const& bytes)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), bytes.size());
+	}
+}
+
+TEST(PatternDatabaseTest, DefaultPartition)
+{
+	using partition_t = pattern_database<4>::partition_t;
+
+	EXPECT_EQ(pattern_database<3>::default_partition(), (partition_t{ {1, 2, 3, 4}, {5, 6, 7, 8} }));
+	EXPECT_EQ(pattern_database<4>::default_partition(),
+		(partition_t{ {1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15} }));
+}
+
+TEST(PatternDatabaseTest, InvalidPartition)
+{
+	EXPECT_THROW(pattern_database<3>({ {1, 2}, {2, 3} }), std::invalid_argument);
+	EXPECT_THROW(pattern_database<3>({ {0, 1} }), std::invalid_argument);
+	EXPECT_THROW(pattern_database<3>({ {8, 9} }), std::invalid_argument);
+
+	// Too many states to build the tables
+	EXPECT_THROW(pattern_database<4>({ {1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15} }), std::invalid_argument);
+	EXPECT_THROW(pattern_database<4>({ {1, 2, 3, 4, 5, 6, 7} }), std::invalid_argument);
+
+	pattern_database<5>::partition_t all_tiles(1);
+	for (int tile = 1 ; tile < 25 ; tile++)
+		all_tiles[0].push_back(tile);
+
+	EXPECT_THROW(pattern_database<5>{ all_tiles }, std::invalid_argument);
+}
+
+TEST(PatternDatabaseTest, TableSize)
+{
+	// 16 * 15 * 14 * 13 * 12 placements of each pattern, 4 bits each
+	EXPECT_EQ(the_4x4_database().size_bytes(), 3 * 524160 / 2);
+	EXPECT_EQ(the_3x3_database().size_bytes(), 2 * 3024 / 2);
+}
+
+TEST(PatternDatabaseTest, SolvedIsZero)
+{
+	EXPECT_EQ(the_3x3_database()(n_sq_puzzle<3>()), 0);
+	EXPECT_EQ(the_4x4_database()(n_sq_puzzle<4>()), 0);
+}
+
+TEST(PatternDatabaseTest, AdmissibleAndDominatesTaxicab)
+{
+	n_sq_puzzle<3> const goal;
+	auto const& pdb = the_3x3_database();
+
+	for (unsigned int seed = 1 ; seed <= 32 ; seed++)
+	{
+		n_sq_puzzle<3> const puz = random_walk<n_sq_puzzle<3>>(seed, 100);
+
+		std::vector<n_sq_puzzle<3>> path;
+		size_t cost = 0;
+		ASSERT_TRUE(astar::a_star_search(
+			puz, &expand<3>, std::cref(pdb),
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost));
+
+		size_t taxicab_cost = 0;
+		std::vector<n_sq_puzzle<3>> taxicab_path;
+		ASSERT_TRUE(astar::a_star_search(
+			puz, &expand<3>, taxicab_heuristic<3>(),
+			[](n_sq_puzzle<3> const&, n_sq_puzzle<3> const&) { return size_t(1); },
+			[](n_sq_puzzle<3> const& p) { return p.is_solved(); },
+			std::back_inserter(taxicab_path), &taxicab_cost));
+
+		EXPECT_EQ(cost, taxicab_cost);
+
+		// Every node on an optimal path is that much closer to the goal
+		for (size_t i = 0 ; i < path.size() ; i++)
+		{
+			size_t const h = pdb(path[i]);
+			EXPECT_LE(h, cost - i);
+			EXPECT_GE(h, tile_taxicab_dist(path[i], goal));
+		}
+	}
+}
+
+TEST(PatternDatabaseTest, Solve15Puzzle)
+{
+	auto const& pdb = the_4x4_database();
+	n_sq_puzzle<4> const puz = random_walk<n_sq_puzzle<4>>(1, 200);
+
+	astar::search_stats taxicab_stats;
+	size_t taxicab_cost = 0;
+	std::vector<n_sq_puzzle<4>> taxicab_path;
+	ASSERT_TRUE(astar::ida_star_search(
+		puz, &expand<4>, taxicab_heuristic<4>(),
+		[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+		[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+		std::back_inserter(taxicab_path), &taxicab_cost,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(taxicab_stats)));
+
+	astar::search_stats stats;
+	size_t cost = 0;
+	std::vector<n_sq_puzzle<4>> path;
+	ASSERT_TRUE(astar::ida_star_search(
+		puz, &expand<4>, std::cref(pdb),
+		[](n_sq_puzzle<4> const&, n_sq_puzzle<4> const&) { return size_t(1); },
+		[](n_sq_puzzle<4> const& p) { return p.is_solved(); },
+		std::back_inserter(path), &cost,
+		std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats)));
+
+	EXPECT_EQ(cost, taxicab_cost);
+	EXPECT_LT(stats.nodes_expanded, taxicab_stats.nodes_expanded);
+}
+
+TEST(PatternDatabaseTest, SaveAndOpen)
+{
+	std::string const path = testing::TempDir() + "pdb_save_and_open.bin";
+
+	auto const& pdb = the_3x3_database();
+	pdb.save(path);
+
+	auto const opened = pattern_database<3>::open(path);
+	EXPECT_EQ(opened.partition(), pdb.partition());
+	EXPECT_EQ(opened.size_bytes(), pdb.size_bytes());
+	EXPECT_EQ(opened.compute_checksum(), pdb.compute_checksum());
+	EXPECT_TRUE(opened.verify_checksum());
+
+	for (unsigned int seed = 1 ; seed <= 100 ; seed++)
+	{
+		n_sq_puzzle<3> const puz = random_walk<n_sq_puzzle<3>>(seed, 60);
+		EXPECT_EQ(opened(puz), pdb(puz)) << puz;
+	}
+}
+
+TEST(PatternDatabaseTest, CorruptTable)
+{
+	std::string const path = testing::TempDir() + "pdb_corrupt_table.bin";
+	the_3x3_database().save(path);
+
+	// The first table starts on the first page after the header
+	std::vector<char> bytes = read_file(path);
+	ASSERT_GT(bytes.size(), 4096u);
+	bytes[4096] ^= 0x10;
+	write_file(path, bytes);
+
+	EXPECT_FALSE(pattern_database<3>::open(path).verify_checksum());
+}
+
+TEST(PatternDatabaseTest, InvalidFile)
+{
+	std::string const path = testing::TempDir() + "pdb_invalid_file.bin";
+	the_3x3_database().save(path);
+	std::vector<char> const bytes = read_file(path);
+
+	EXPECT_THROW(pattern_database<3>::open(testing::TempDir() + "no_such_pdb.bin"), std::runtime_error);
+	EXPECT_THROW(pattern_database<4>::open(path), std::runtime_error);
+
+	std::vector<char> bad_magic = bytes;
+	bad_magic[0] = 'X';
+	write_file(path, bad_magic);
+	EXPECT_THROW(pattern_database<3>::open(path), std::runtime_error);
+
+	std::vector<char> bad_version = bytes;
+	bad_version[8]++;
+	write_file(path, bad_version);
+	EXPECT_THROW(pattern_database<3>::open(path), std::runtime_error);
+
+	write_file(path, std::vector<char>(bytes.begin(), bytes.end() - 1));
+	EXPECT_THROW(pattern_database<3>::open(path), std::runtime_error);
+
+	write_file(path, std::vector<char>(bytes.begin(), bytes.begin() + 40));
+	EXPECT_THROW(pattern_database<3>::open(path), std::runtime_error);
+}
@@ -0,0 +1,166 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <n_sq_puzzle.hpp>
+#include <solve_helpers.hpp>
+#include <puzzle_heuristics.hpp>
+
+#include <astar/ida_star_search.hpp>
+#include <astar/search_stats.hpp>
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "random_walk.h"
+
+using namespace cds;
+
+namespace
+{
+	template <size_t N, typename CostFn>
+	bool solve(n_sq_puzzle<N> const& puz, CostFn cost_fn, std::vector<n_sq_puzzle<N>>& path,
+		size_t& cost, astar::search_stats& stats)
+	{
+		using policy_t = astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>;
+
+		return astar::ida_star_search<policy_t>(
+			puz, &expand<N>, cost_fn,
+			[](n_sq_puzzle<N> const&, n_sq_puzzle<N> const&) { return size_t(1); },
+			[](n_sq_puzzle<N> const& p) { return p.is_solved(); },
+			std::back_inserter(path), &cost,
+			std::numeric_limits<size_t>::max(), astar::search_stats_observer(stats));
+	}
+}
+
+template <template <size_t> class Heuristic, size_t N>
+struct PuzzleHeuristic
+{
+	using heuristic_t = Heuristic<N>;
+	using puzzle_t = n_sq_puzzle<N>;
+	static constexpr size_t dim = N;
+};
+
+template <typename T>
+class PuzzleHeuristicTest : public testing::Test { };
+
+using PuzzleHeuristicTestImplementations =
+	testing::Types<
+		PuzzleHeuristic<linear_conflict_heuristic, 3>,
+		PuzzleHeuristic<linear_conflict_heuristic, 4>,
+		PuzzleHeuristic<linear_conflict_heuristic, 5>,
+		PuzzleHeuristic<walking_distance_heuristic, 3>,
+		PuzzleHeuristic<walking_distance_heuristic, 4>>;
+
+TYPED_TEST_SUITE(PuzzleHeuristicTest, PuzzleHeuristicTestImplementations);
+
+TYPED_TEST(PuzzleHeuristicTest, SolvedIsZero)
+{
+	typename TypeParam::heuristic_t const h;
+	EXPECT_EQ(h(typename TypeParam::puzzle_t()), 0);
+}
+
+TYPED_TEST(PuzzleHeuristicTest, IncrementalMatchesFull)
+{
+	using puzzle_t = typename TypeParam::puzzle_t;
+	using MoveType = typename puzzle_t::MoveType;
+
+	typename TypeParam::heuristic_t const h;
+
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<int> random_move(0, 3);
+
+	puzzle_t puz;
+	size_t dist = h(puz);
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		puzzle_t const parent = puz;
+		if (!puz.move(static_cast<MoveType>(random_move(gen))))
+			continue;
+
+		dist = h(parent, dist, puz);
+		ASSERT_EQ(dist, h(puz)) << puz;
+	}
+}
+
+TYPED_TEST(PuzzleHeuristicTest, AdmissibleAndDominatesTaxicab)
+{
+	constexpr size_t dim = TypeParam::dim;
+	if (dim > 4)
+		return;	// Too slow to solve
+
+	typename TypeParam::heuristic_t const h;
+	taxicab_heuristic<dim> const taxicab;
+
+	for (unsigned int seed = 1 ; seed <= 16 ; seed++)
+	{
+		auto const puz = random_walk<n_sq_puzzle<dim>>(seed, dim == 3 ? 100 : 50);
+
+		std::vector<typename TypeParam::puzzle_t> path;
+		size_t cost = 0;
+		astar::search_stats stats;
+		ASSERT_TRUE(solve(puz, taxicab, path, cost, stats));
+
+		// Every node on an optimal path is that much closer to the goal
+		for (size_t i = 0 ; i < path.size() ; i++)
+		{
+			EXPECT_LE(h(path[i]), cost - i) << path[i];
+			EXPECT_GE(h(path[i]), taxicab(path[i])) << path[i];
+		}
+	}
+}
+
+TYPED_TEST(PuzzleHeuristicTest, ExpandsFewerNodesThanTaxicab)
+{
+	constexpr size_t dim = TypeParam::dim;
+	if (dim != 4)
+		return;
+
+	typename TypeParam::heuristic_t const h;
+	auto const puz = random_walk<n_sq_puzzle<dim>>(1, 200);
+
+	std::vector<typename TypeParam::puzzle_t> taxicab_path;
+	size_t taxicab_cost = 0;
+	astar::search_stats taxicab_stats;
+	ASSERT_TRUE(solve(puz, taxicab_heuristic<dim>(), taxicab_path, taxicab_cost, taxicab_stats));
+
+	std::vector<typename TypeParam::puzzle_t> path;
+	size_t cost = 0;
+	astar::search_stats stats;
+	ASSERT_TRUE(solve(puz, std::cref(h), path, cost, stats));
+
+	EXPECT_EQ(cost, taxicab_cost);
+	EXPECT_LT(stats.nodes_expanded, taxicab_stats.nodes_expanded);
+}
+
+TEST(LinearConflictHeuristicTest, RowConflicts)
+{
+	// 1 has to get past 2 and 3, so one of them has to leave the row
+	n_sq_puzzle<3> puz;
+	ASSERT_TRUE(puz.set({ 2, 3, 1, 4, 5, 6, 7, 8, 0 }));
+
+	EXPECT_EQ(taxicab_heuristic<3>()(puz), 4);
+	EXPECT_EQ(linear_conflict_heuristic<3>()(puz), 6);
+	EXPECT_GE(walking_distance_heuristic<3>()(puz), 6);
+}
+
+TEST(WalkingDistanceHeuristicTest, NumStates)
+{
+	// Sizes of the row (and column) state spaces
+	EXPECT_EQ(walking_distance_heuristic<3>().num_states(), 2 * 105);
+	EXPECT_EQ(walking_distance_heuristic<4>().num_states(), 2 * 24964);
+}
@@ -0,0 +1,34 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <random>
+
+/// Scrambles a solved puzzle with num_moves random moves, (some of which
+/// may not be possible, and are skipped) so that the result is always solvable.
+/// The same seed always gives the same puzzle.
+template <typename Puzzle>
+Puzzle random_walk(unsigned int seed, size_t num_moves)
+{
+	using MoveType = typename Puzzle::MoveType;
+
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> random_move(0, 3);
+
+	Puzzle puz;
+	for (size_t i = 0 ; i < num_moves ; i++)
+		puz.move(static_cast<MoveType>(random_move(gen)));
+
+	return puz;
+}
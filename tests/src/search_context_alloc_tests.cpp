@@ -0,0 +1,58 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Checks that searches don't allocate. This replaces the global operator new,
+// (see alloc_counter.cpp) so it has its own test executable.
+
+#include <gtest/gtest.h>
+
+#include <astar/search_context.hpp>
+
+#include <alloc_counter.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include "search_context_grid.h"
+
+using namespace cds;
+using namespace search_context_grid;
+
+TEST(SearchContextTest, NoAllocationsAfterWarmup)
+{
+	astar::search_context<int, manhattan_dist> context;
+
+	std::vector<int> path;
+	path.reserve(theGridDim * theGridDim);
+
+	auto run_queries = [&context, &path]
+	{
+		for (auto const& q : theQueries)
+		{
+			path.clear();
+			bool const found = context.search(
+				q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight,
+				[goal = q.second](int n) { return n == goal; },
+				std::back_inserter(path));
+
+			EXPECT_TRUE(found);
+		}
+	};
+
+	run_queries();
+
+	size_t const allocations_before = allocation_count();
+	run_queries();
+	run_queries();
+
+	EXPECT_EQ(allocation_count() - allocations_before, 0);
+}
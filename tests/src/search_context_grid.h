@@ -0,0 +1,83 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+// Grid and queries shared by the search_context tests
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace search_context_grid
+{
+	constexpr int theGridDim = 64;
+
+	// Fixed capacity neighbor list, so expanding a node doesn't allocate
+	struct grid_neighbors
+	{
+		std::array<int, 4> nodes;
+		size_t count = 0;
+
+		int const* begin() const { return nodes.data(); }
+		int const* end() const { return nodes.data() + count; }
+	};
+
+	inline bool is_obstacle(int n)
+	{
+		int const x = n % theGridDim;
+		int const y = n / theGridDim;
+
+		// Walls with a gap at alternating ends
+		return (x % 8 == 4) && ((x / 8) % 2 == 0 ? y != theGridDim - 1 : y != 0);
+	}
+
+	inline grid_neighbors expand_grid(int n)
+	{
+		grid_neighbors neighbors;
+		int const x = n % theGridDim;
+		int const y = n / theGridDim;
+
+		auto add = [&neighbors](int m) { if (!is_obstacle(m)) neighbors.nodes[neighbors.count++] = m; };
+		if (x > 0) add(n - 1);
+		if (x < theGridDim - 1) add(n + 1);
+		if (y > 0) add(n - theGridDim);
+		if (y < theGridDim - 1) add(n + theGridDim);
+
+		return neighbors;
+	}
+
+	inline int grid_weight(int n, int m)
+	{
+		return 1 + (n * 31 + m) % 9;
+	}
+
+	struct manhattan_dist
+	{
+		int goal;
+
+		int operator()(int n) const
+		{
+			return std::abs(n % theGridDim - goal % theGridDim) + std::abs(n / theGridDim - goal / theGridDim);
+		}
+	};
+
+	inline std::vector<std::pair<int, int>> const theQueries = {
+		{ 0, theGridDim * theGridDim - 1 },
+		{ 5, 3 * theGridDim + 61 },
+		{ 10 * theGridDim + 2, 2 },
+		{ 63 * theGridDim + 63, 32 * theGridDim + 31 },
+		{ 7, 7 }
+	};
+} // namespace search_context_grid
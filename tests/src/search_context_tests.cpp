@@ -0,0 +1,97 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/search_context.hpp>
+
+#include <vector>
+#include <iterator>
+
+#include "search_context_grid.h"
+
+using namespace cds;
+using namespace search_context_grid;
+
+TEST(SearchContextTest, SameResultsAsAStarSearch)
+{
+	astar::search_context<int, manhattan_dist> context;
+
+	for (int pass = 0 ; pass < 2 ; pass++)
+	{
+		for (auto const& q : theQueries)
+		{
+			auto const is_goal = [goal = q.second](int n) { return n == goal; };
+
+			std::vector<int> expected_path;
+			int expected_cost = 0;
+			bool const expected_found = astar::a_star_search(
+				q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight, is_goal,
+				std::back_inserter(expected_path), &expected_cost);
+
+			std::vector<int> path;
+			int cost = 0;
+			bool const found = context.search(
+				q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight, is_goal,
+				std::back_inserter(path), &cost);
+
+			ASSERT_TRUE(expected_found);
+			EXPECT_EQ(found, expected_found);
+			EXPECT_EQ(cost, expected_cost);
+			EXPECT_EQ(path.front(), q.first);
+			EXPECT_EQ(path.back(), q.second);
+			EXPECT_EQ(path.size(), expected_path.size());
+		}
+	}
+
+	context.clear();
+	EXPECT_EQ(context.num_nodes(), 0);
+}
+
+TEST(SearchContextTest, SearchSummary)
+{
+	astar::search_context<int, manhattan_dist> context;
+
+	for (auto const& q : theQueries)
+	{
+		auto const is_goal = [goal = q.second](int n) { return n == goal; };
+
+		std::vector<int> path;
+		int cost = 0;
+		ASSERT_TRUE(context.search(
+			q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight, is_goal,
+			std::back_inserter(path), &cost));
+
+		auto const summary = context.search_summary(
+			q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight, is_goal);
+
+		ASSERT_TRUE(summary.has_value());
+		EXPECT_EQ(summary->num_nodes, path.size());
+		EXPECT_EQ(summary->cost, cost);
+
+		auto const free_summary = astar::a_star_path_summary(
+			q.first, &expand_grid, manhattan_dist{q.second}, &grid_weight, is_goal);
+
+		ASSERT_TRUE(free_summary.has_value());
+		EXPECT_EQ(free_summary->num_nodes, summary->num_nodes);
+		EXPECT_EQ(free_summary->cost, summary->cost);
+	}
+
+	// Goal is inside a wall, so it can't be reached
+	int const wall_node = 10 * theGridDim + 4;
+	auto const no_path = context.search_summary(
+		0, &expand_grid, manhattan_dist{wall_node}, &grid_weight,
+		[wall_node](int n) { return n == wall_node; });
+
+	EXPECT_FALSE(no_path.has_value());
+}
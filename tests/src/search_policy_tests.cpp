@@ -0,0 +1,173 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+
+#include <map>
+#include <vector>
+#include <iterator>
+
+#include "get_path_cost.h"
+
+using namespace cds;
+
+namespace
+{
+	using adj_list_graph_t = std::map<char, std::map<char, int>>;
+
+	// Optimal path is s -> a -> c -> z (cost 12), but h(a) is admissible
+	// and inconsistent, so c is first expanded via b (cost 4 instead of 2)
+	adj_list_graph_t const theInconsistentGraph = {
+		{ 's', {{'a', 1}, {'b', 1}} },
+		{ 'a', {{'s', 1}, {'c', 1}} },
+		{ 'b', {{'s', 1}, {'c', 3}} },
+		{ 'c', {{'a', 1}, {'b', 3}, {'z', 10}} },
+		{ 'z', {{'c', 10}} }
+	};
+
+	int inconsistent_heuristic(char n)
+	{
+		return n == 'a' ? 11 : 0;
+	}
+
+	std::vector<char> expand_graph(char n)
+	{
+		std::vector<char> neighbors;
+		for (auto const& nw : theInconsistentGraph.at(n))
+			neighbors.push_back(nw.first);
+
+		return neighbors;
+	}
+
+	int graph_weight(char n, char m)
+	{
+		return theInconsistentGraph.at(n).at(m);
+	}
+
+	template <typename Policy>
+	bool search_inconsistent_graph(std::vector<char>& path, int& path_cost, std::map<char, int>& num_expansions)
+	{
+		return astar::a_star_search<Policy>(
+			's',
+			[&num_expansions](char n) { num_expansions[n]++; return expand_graph(n); },
+			&inconsistent_heuristic,
+			&graph_weight,
+			[](char n) { return n == 'z'; },
+			std::back_inserter(path),
+			&path_cost);
+	}
+}
+
+template <typename Fringe>
+class SearchPolicyTest : public testing::Test
+{
+};
+
+using SearchPolicyTestFringes =
+	testing::Types<astar::lazy_fringe, astar::binary_heap_fringe, astar::d_ary_heap_fringe<4>, astar::bucket_fringe<>>;
+
+TYPED_TEST_SUITE(SearchPolicyTest, SearchPolicyTestFringes);
+
+TYPED_TEST(SearchPolicyTest, NeverReopen)
+{
+	using policy_t = astar::search_policy<TypeParam, astar::ReopenPolicy::NEVER>;
+
+	std::vector<char> path;
+	int path_cost = 0;
+	std::map<char, int> num_expansions;
+
+	ASSERT_TRUE(search_inconsistent_graph<policy_t>(path, path_cost, num_expansions));
+
+	// c isn't reopened, so we get the path through b
+	EXPECT_EQ(path, (std::vector<char>{ 's', 'b', 'c', 'z' }));
+	EXPECT_EQ(path_cost, 14);
+
+	for (auto const& n_count : num_expansions)
+		EXPECT_EQ(n_count.second, 1) << n_count.first;
+}
+
+TYPED_TEST(SearchPolicyTest, ReopenOnBetterCost)
+{
+	using policy_t = astar::search_policy<TypeParam, astar::ReopenPolicy::ON_BETTER_COST>;
+
+	std::vector<char> path;
+	int path_cost = 0;
+	std::map<char, int> num_expansions;
+
+	ASSERT_TRUE(search_inconsistent_graph<policy_t>(path, path_cost, num_expansions));
+
+	EXPECT_EQ(path, (std::vector<char>{ 's', 'a', 'c', 'z' }));
+	EXPECT_EQ(path_cost, 12);
+	EXPECT_EQ(get_path_cost(path.begin(), path.end(), &graph_weight), path_cost);
+
+	EXPECT_EQ(num_expansions['c'], 2);
+}
+
+TYPED_TEST(SearchPolicyTest, NoStaleExpansions)
+{
+	// Weighted grid, with the zero heuristic (consistent), every node is expanded at most once
+	constexpr int dim = 16;
+	auto weight = [](int n, int m) { return 1 + (n * 31 + m) % 9; };
+	auto expand = [](int n)
+	{
+		std::vector<int> neighbors;
+		int const x = n % dim;
+		int const y = n / dim;
+		if (x > 0) neighbors.push_back(n - 1);
+		if (x < dim - 1) neighbors.push_back(n + 1);
+		if (y > 0) neighbors.push_back(n - dim);
+		if (y < dim - 1) neighbors.push_back(n + dim);
+
+		return neighbors;
+	};
+
+	std::map<int, int> num_expansions;
+	std::vector<int> path;
+
+	bool const found = astar::a_star_search<astar::search_policy<TypeParam>>(
+		0,
+		[&](int n) { num_expansions[n]++; return expand(n); },
+		[](int) { return 0; },
+		weight,
+		[](int n) { return n == dim * dim - 1; },
+		std::back_inserter(path));
+
+	ASSERT_TRUE(found);
+
+	for (auto const& n_count : num_expansions)
+		EXPECT_EQ(n_count.second, 1) << n_count.first;
+}
+
+TEST(BucketFringeTest, LargeEdgeWeights)
+{
+	// f is the same for every node on the line, but g goes up to num_nodes * weight,
+	// so g buckets from 0 to the node's g would take a lot of memory
+	constexpr int num_nodes = 100;
+	constexpr int weight = 100000;
+
+	std::vector<int> path;
+	int path_cost = 0;
+	bool const found = astar::a_star_search<astar::search_policy<astar::bucket_fringe<>>>(
+		0,
+		[](int n) { return n < num_nodes ? std::vector<int>{ n + 1 } : std::vector<int>(); },
+		[](int n) { return (num_nodes - n) * weight; },
+		[](int, int) { return weight; },
+		[](int n) { return n == num_nodes; },
+		std::back_inserter(path),
+		&path_cost);
+
+	ASSERT_TRUE(found);
+	EXPECT_EQ(path.size(), num_nodes + 1);
+	EXPECT_EQ(path_cost, num_nodes * weight);
+}
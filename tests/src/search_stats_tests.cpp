@@ -0,0 +1,216 @@
+// Copyright (C) 2018 by Christopher Schadl <cschadl@gmail.com>
+
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted.
+
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD 
+// TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+// DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <astar/a_star_search.hpp>
+#include <astar/ida_star_search.hpp>
+#include <astar/search_context.hpp>
+#include <astar/search_stats.hpp>
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <iterator>
+
+using namespace cds;
+
+namespace
+{
+	struct weighted_grid
+	{
+		int dim;
+
+		std::vector<int> expand(int n) const
+		{
+			std::vector<int> neighbors;
+			int const x = n % dim;
+			int const y = n / dim;
+
+			if (x > 0) neighbors.push_back(n - 1);
+			if (x < dim - 1) neighbors.push_back(n + 1);
+			if (y > 0) neighbors.push_back(n - dim);
+			if (y < dim - 1) neighbors.push_back(n + dim);
+
+			return neighbors;
+		}
+
+		int weight(int n, int m) const
+		{
+			return 1 + (n * 31 + m) % 9;
+		}
+
+		int manhattan_dist(int n, int goal) const
+		{
+			return std::abs(n % dim - goal % dim) + std::abs(n / dim - goal / dim);
+		}
+	};
+
+	using adj_list_graph_t = std::map<char, std::map<char, int>>;
+
+	// Optimal path is s -> a -> c -> z, h(a) is inconsistent, so c has to be reopened
+	adj_list_graph_t const theInconsistentGraph = {
+		{ 's', {{'a', 1}, {'b', 1}} },
+		{ 'a', {{'s', 1}, {'c', 1}} },
+		{ 'b', {{'s', 1}, {'c', 3}} },
+		{ 'c', {{'a', 1}, {'b', 3}, {'z', 10}} },
+		{ 'z', {{'c', 10}} }
+	};
+}
+
+TEST(SearchStatsTest, AStarCounts)
+{
+	weighted_grid const grid{16};
+	int const goal = grid.dim * grid.dim - 1;
+
+	size_t num_expand_calls = 0;
+
+	astar::search_stats stats;
+	std::vector<int> path;
+	bool const found = astar::a_star_search(
+		0,
+		[&grid, &num_expand_calls](int n) { num_expand_calls++; return grid.expand(n); },
+		[&grid, goal](int n) { return grid.manhattan_dist(n, goal); },
+		[&grid](int n, int m) { return grid.weight(n, m); },
+		[goal](int n) { return n == goal; },
+		std::back_inserter(path),
+		nullptr,
+		std::numeric_limits<int>::max(),
+		astar::search_stats_observer(stats));
+
+	ASSERT_TRUE(found);
+
+	EXPECT_EQ(stats.iterations, 1);
+	EXPECT_EQ(stats.nodes_expanded, num_expand_calls);
+	EXPECT_GE(stats.nodes_generated, stats.nodes_expanded);
+	EXPECT_GT(stats.stale_entries, 0);	// the lazy fringe keeps stale entries
+	EXPECT_EQ(stats.nodes_reopened, 0);
+
+	EXPECT_GE(stats.peak_num_nodes, path.size());
+	EXPECT_GT(stats.peak_fringe_size, 0);
+	EXPECT_GT(stats.peak_memory, 0);
+	EXPECT_GT(stats.search_time.count(), 0);
+	EXPECT_GT(stats.path_time.count(), 0);
+}
+
+TEST(SearchStatsTest, AStarReopenedNodes)
+{
+	astar::search_stats stats;
+	std::vector<char> path;
+	bool const found = astar::a_star_search<astar::search_policy<astar::lazy_fringe, astar::ReopenPolicy::ON_BETTER_COST>>(
+		's',
+		[](char n)
+		{
+			std::vector<char> neighbors;
+			for (auto const& nw : theInconsistentGraph.at(n))
+				neighbors.push_back(nw.first);
+
+			return neighbors;
+		},
+		[](char n) { return n == 'a' ? 11 : 0; },
+		[](char n, char m) { return theInconsistentGraph.at(n).at(m); },
+		[](char n) { return n == 'z'; },
+		std::back_inserter(path),
+		nullptr,
+		std::numeric_limits<int>::max(),
+		astar::search_stats_observer(stats));
+
+	ASSERT_TRUE(found);
+	EXPECT_EQ(stats.nodes_reopened, 1);
+}
+
+TEST(SearchStatsTest, SearchContextAccumulates)
+{
+	weighted_grid const grid{16};
+	int const goal = grid.dim * grid.dim - 1;
+
+	astar::search_context<int, std::function<int(int)>> context;
+	astar::search_stats stats;
+
+	for (int i = 0 ; i < 2 ; i++)
+	{
+		auto const summary = context.search_summary(
+			0,
+			[&grid](int n) { return grid.expand(n); },
+			[&grid, goal](int n) { return grid.manhattan_dist(n, goal); },
+			[&grid](int n, int m) { return grid.weight(n, m); },
+			[goal](int n) { return n == goal; },
+			std::numeric_limits<int>::max(),
+			astar::search_stats_observer(stats));
+
+		ASSERT_TRUE(summary.has_value());
+	}
+
+	// Counts add up over searches, peaks don't
+	EXPECT_EQ(stats.iterations, 2);
+	EXPECT_EQ(stats.nodes_expanded % 2, 0);
+	EXPECT_LE(stats.peak_num_nodes, static_cast<size_t>(grid.dim * grid.dim));
+	EXPECT_EQ(stats.path_time.count(), 0);	// no path was written
+}
+
+TEST(SearchStatsTest, IDAStarCounts)
+{
+	weighted_grid const grid{6};
+	int const goal = grid.dim * grid.dim - 1;
+
+	size_t num_expand_calls = 0;
+
+	astar::search_stats stats;
+	std::vector<int> path;
+	bool const found = astar::ida_star_search<astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>>(
+		0,
+		[&grid, &num_expand_calls](int n) { num_expand_calls++; return grid.expand(n); },
+		[&grid, goal](int n) { return grid.manhattan_dist(n, goal); },
+		[&grid](int n, int m) { return grid.weight(n, m); },
+		[goal](int n) { return n == goal; },
+		std::back_inserter(path),
+		nullptr,
+		std::numeric_limits<int>::max(),
+		astar::search_stats_observer(stats));
+
+	ASSERT_TRUE(found);
+
+	EXPECT_GT(stats.iterations, 1);
+	EXPECT_EQ(stats.nodes_expanded, num_expand_calls);
+	EXPECT_GE(stats.nodes_generated, stats.nodes_expanded);
+	EXPECT_EQ(stats.stale_entries, 0);
+	EXPECT_EQ(stats.peak_fringe_size, 0);
+	EXPECT_GE(stats.peak_num_nodes, path.size());
+	EXPECT_GT(stats.search_time.count(), 0);
+}
+
+TEST(SearchStatsTest, AddCounts)
+{
+	astar::search_stats worker_stats;
+	worker_stats.nodes_expanded = 5;
+	worker_stats.nodes_generated = 12;
+	worker_stats.nodes_reopened = 1;
+	worker_stats.stale_entries = 3;
+	worker_stats.iterations = 7;
+	worker_stats.peak_num_nodes = 100;
+
+	astar::search_stats stats;
+	astar::search_stats_observer observer(stats);
+	observer.node_expanded();
+	observer.add_counts(worker_stats);
+	observer.add_counts(worker_stats);
+
+	// Just the counts, not the iterations or peaks
+	EXPECT_EQ(stats.nodes_expanded, 11);
+	EXPECT_EQ(stats.nodes_generated, 24);
+	EXPECT_EQ(stats.nodes_reopened, 2);
+	EXPECT_EQ(stats.stale_entries, 6);
+	EXPECT_EQ(stats.iterations, 0);
+	EXPECT_EQ(stats.peak_num_nodes, 0);
+
+	astar::null_search_observer().add_counts(worker_stats);
+}
@@ -14,10 +14,14 @@
 
 #include <astar/a_star_search.hpp>
 #include <astar/ida_star_search.hpp>
+#include <astar/bidirectional_a_star_search.hpp>
+#include <astar/hda_star_search.hpp>
+#include <astar/parallel_ida_star_search.hpp>
 
 #include <vector>
 #include <unordered_set>
 #include <limits>
+#include <optional>
 #include <cmath>
 
 #include "get_path_cost.h"
@@ -72,8 +76,8 @@ namespace
 		{
 			for (int j = 0 ; j < node_deltas.size(); j++)
 			{
-				if (i == 0 && j == 0)
-					continue;
+				if (node_deltas[i] == 0 && node_deltas[j] == 0)
+					continue;	// Not a neighbor of itself
 
 				grid_node expand_node{ n.x + node_deltas[i], n.y + node_deltas[j] };
 
@@ -146,6 +150,9 @@ namespace
 			std::vector<grid_node>& out_path,
 			double& path_cost) = 0;
 
+		virtual std::optional<astar::path_summary<double>> doSummary(
+			grid_node const& start_node) = 0;
+
 		grid_node const& goal_node() const { return m_goal_node; }
 	};
 }
@@ -155,6 +162,7 @@ namespace
 // GridSearchShortestPathTest/(anonymous namespace)::AStartGridSearchTest
 // when we run the tests, which is a little hard to read
 
+template <typename Policy = astar::default_search_policy>
 class AStarGridSearchTest : public GridSearchTest
 {
 public:
@@ -169,7 +177,7 @@ public:
 		std::vector<grid_node>& out_path, 
 		double& path_cost) override
 	{
-		return astar::a_star_search(
+		return astar::a_star_search<Policy>(
 			start_node,
 			[this](grid_node const& n) { return expand(n); },
 			[this](grid_node const& n) { return heuristic(n); },
@@ -177,8 +185,19 @@ public:
 			[this](grid_node const& n) { return is_goal(n); },
 			std::back_inserter(out_path), &path_cost);
 	}
+
+	std::optional<astar::path_summary<double>> doSummary(grid_node const& start_node) override
+	{
+		return astar::a_star_path_summary<Policy>(
+			start_node,
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return heuristic(n); },
+			node_dist,
+			[this](grid_node const& n) { return is_goal(n); });
+	}
 };
 
+template <typename Policy = astar::default_ida_search_policy>
 class IDAStarGridSearchTest : public GridSearchTest
 {
 public:
@@ -193,7 +212,7 @@ public:
 		std::vector<grid_node>& out_path, 
 		double& path_cost) override
 	{
-		return astar::ida_star_search(
+		return astar::ida_star_search<Policy>(
 			start_node,
 			[this](grid_node const& n) { return expand(n); },
 			[this](grid_node const& n) { return heuristic(n); },
@@ -201,6 +220,128 @@ public:
 			[this](grid_node const& n) { return is_goal(n); },
 			std::back_inserter(out_path), &path_cost);
 	}
+
+	std::optional<astar::path_summary<double>> doSummary(grid_node const& start_node) override
+	{
+		return astar::ida_star_path_summary<Policy>(
+			start_node,
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return heuristic(n); },
+			node_dist,
+			[this](grid_node const& n) { return is_goal(n); });
+	}
+};
+
+template <typename Policy = astar::default_search_policy>
+class BidirectionalAStarGridSearchTest : public GridSearchTest
+{
+public:
+	BidirectionalAStarGridSearchTest()
+		: GridSearchTest(theObstacles, grid_node{7, 3})
+	{
+
+	}
+
+	bool doSearch(
+		grid_node const& start_node,
+		std::vector<grid_node>& out_path,
+		double& path_cost) override
+	{
+		// The grid is undirected, so expand() also gives a node's predecessors
+		return astar::bidirectional_a_star_search<Policy>(
+			start_node,
+			m_goal_node,
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return heuristic(n); },
+			[start_node](grid_node const& n) { return node_dist(n, start_node); },
+			node_dist,
+			std::back_inserter(out_path), &path_cost);
+	}
+
+	std::optional<astar::path_summary<double>> doSummary(grid_node const& start_node) override
+	{
+		// There's no bidirectional summary search, so summarize the path
+		std::vector<grid_node> path;
+		double path_cost;
+		if (!doSearch(start_node, path, path_cost))
+			return std::nullopt;
+
+		return astar::path_summary<double>{ path.size(), path_cost };
+	}
+};
+
+template <typename Policy = astar::default_search_policy, unsigned int NumThreads = 4>
+class HDAStarGridSearchTest : public GridSearchTest
+{
+public:
+	HDAStarGridSearchTest()
+		: GridSearchTest(theObstacles, grid_node{7, 3})
+	{
+
+	}
+
+	bool doSearch(
+		grid_node const& start_node,
+		std::vector<grid_node>& out_path,
+		double& path_cost) override
+	{
+		return astar::hda_star_search<Policy>(
+			start_node,
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return heuristic(n); },
+			node_dist,
+			[this](grid_node const& n) { return is_goal(n); },
+			std::back_inserter(out_path), &path_cost,
+			std::numeric_limits<double>::max(), NumThreads);
+	}
+
+	std::optional<astar::path_summary<double>> doSummary(grid_node const& start_node) override
+	{
+		std::vector<grid_node> path;
+		double path_cost;
+		if (!doSearch(start_node, path, path_cost))
+			return std::nullopt;
+
+		return astar::path_summary<double>{ path.size(), path_cost };
+	}
+};
+
+template <typename Policy = astar::default_ida_search_policy, unsigned int NumThreads = 4>
+class ParallelIDAStarGridSearchTest : public GridSearchTest
+{
+public:
+	ParallelIDAStarGridSearchTest()
+		: GridSearchTest(theObstacles, grid_node{7, 3})
+	{
+
+	}
+
+	bool doSearch(
+		grid_node const& start_node,
+		std::vector<grid_node>& out_path,
+		double& path_cost) override
+	{
+		// Split close to the root, so the small grid still makes several work items
+		return astar::parallel_ida_star_search<Policy>(
+			start_node,
+			[this](grid_node const& n) { return expand(n); },
+			[this](grid_node const& n) { return heuristic(n); },
+			node_dist,
+			[this](grid_node const& n) { return is_goal(n); },
+			std::back_inserter(out_path), &path_cost,
+			std::numeric_limits<double>::max(), NumThreads, 2);
+	}
+
+	std::optional<astar::path_summary<double>> doSummary(grid_node const& start_node) override
+	{
+		std::vector<grid_node> path;
+		double path_cost;
+		if (!doSearch(start_node, path, path_cost))
+			return std::nullopt;
+
+		return astar::path_summary<double>{ path.size(), path_cost };
+	}
 };
 
 template <typename T>
@@ -211,7 +352,28 @@ protected:
 };
 
 using GridSearchShortestPathTestImplementations =
-	testing::Types<AStarGridSearchTest, IDAStarGridSearchTest>;
+	testing::Types<
+		AStarGridSearchTest<>,
+		AStarGridSearchTest<astar::search_policy<astar::binary_heap_fringe>>,
+		AStarGridSearchTest<
+			astar::search_policy<astar::lazy_fringe, astar::ReopenPolicy::NEVER, astar::arena_node_storage>>,
+		AStarGridSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		IDAStarGridSearchTest<>,
+		IDAStarGridSearchTest<astar::ida_search_policy<astar::flat_node_storage>>,
+		IDAStarGridSearchTest<astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>>,
+		IDAStarGridSearchTest<
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<4096>>>,
+		BidirectionalAStarGridSearchTest<>,
+		BidirectionalAStarGridSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		HDAStarGridSearchTest<astar::default_search_policy, 1>,
+		HDAStarGridSearchTest<>,
+		HDAStarGridSearchTest<
+			astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		ParallelIDAStarGridSearchTest<>,
+		ParallelIDAStarGridSearchTest<
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<4096>>>>;
 
 TYPED_TEST_SUITE(GridSearchShortestPathTest, GridSearchShortestPathTestImplementations);
 
@@ -242,3 +404,81 @@ TYPED_TEST(GridSearchShortestPathTest, ShortestPath)
 	EXPECT_TRUE(std::all_of(path.begin(), path.end(),
 		[](grid_node const& n) { return n.x >= 0 && n.y >= 0 && n.x <= 7 && n.y <= 7; }));
 }
+
+TYPED_TEST(GridSearchShortestPathTest, PathSummary)
+{
+	grid_node const start_node{0, 0};
+
+	std::vector<grid_node> path;
+	double path_cost;
+	ASSERT_TRUE(this->theTest.doSearch(start_node, path, path_cost));
+
+	auto const summary = this->theTest.doSummary(start_node);
+	ASSERT_TRUE(summary.has_value());
+
+	EXPECT_EQ(summary->num_nodes, path.size());
+	EXPECT_NEAR(summary->cost, get_path_cost(path.begin(), path.end(), node_dist),
+		std::numeric_limits<double>::epsilon() * 100);
+}
+
+TEST(IDAStarDeepPathTest, NoRecursionLimit)
+{
+	// A path this long would overflow the call stack with a recursive search
+	constexpr int theChainLength = 200000;
+
+	std::vector<int> path;
+	int path_cost = 0;
+	bool const found = astar::ida_star_search(
+		0,
+		[](int n)
+		{
+			std::vector<int> adj;
+			if (n > 0) adj.push_back(n - 1);
+			if (n < theChainLength) adj.push_back(n + 1);
+			return adj;
+		},
+		[](int n) { return theChainLength - n; },
+		[](int, int) { return 1; },
+		[](int n) { return n == theChainLength; },
+		std::back_inserter(path), &path_cost);
+
+	ASSERT_TRUE(found);
+	EXPECT_EQ(path.size(), theChainLength + 1);
+	EXPECT_EQ(path_cost, theChainLength);
+	EXPECT_EQ(path.front(), 0);
+	EXPECT_EQ(path.back(), theChainLength);
+}
+
+TEST(IDAStarDeepPathTest, ExpandsEachNodeOnce)
+{
+	constexpr int theChainLength = 100;
+
+	size_t num_expands = 0;
+	size_t num_heuristic_calls = 0;
+
+	std::vector<int> path;
+	bool const found = astar::ida_star_search(
+		0,
+		[&num_expands](int n)
+		{
+			num_expands++;
+
+			std::vector<int> adj;
+			if (n > 0) adj.push_back(n - 1);
+			if (n < theChainLength) adj.push_back(n + 1);
+			return adj;
+		},
+		[&num_heuristic_calls](int n) { num_heuristic_calls++; return theChainLength - n; },
+		[](int, int) { return 1; },
+		[](int n) { return n == theChainLength; },
+		std::back_inserter(path));
+
+	ASSERT_TRUE(found);
+	EXPECT_EQ(path.size(), theChainLength + 1);
+
+	// The heuristic is exact, so there's a single iteration that expands
+	// every node before the goal, and evaluates the heuristic once for
+	// the start node and once for each successor
+	EXPECT_EQ(num_expands, theChainLength);
+	EXPECT_EQ(num_heuristic_calls, 1 + 1 + (theChainLength - 1) * 2);
+}
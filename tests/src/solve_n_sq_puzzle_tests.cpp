@@ -18,6 +18,8 @@
 #include <astar/a_star_search.hpp>
 #include <astar/ida_star_search.hpp>
 
+#include <random>
+
 using namespace cds;
 
 namespace
@@ -81,9 +83,20 @@ namespace
 			std::vector<n_sq_puzzle<Dim>>& path,
 			std::optional<int> max_cost = std::nullopt) const = 0;
 	};
+
+	/// The solver's heuristic, or the incremental taxicab_heuristic (which doesn't
+	/// compute the distance of a successor from scratch, but the value is the same)
+	template <bool Incremental, size_t Dim>
+	auto solver_heuristic(NSqPuzzleSolver<Dim> const& solver)
+	{
+		if constexpr (Incremental)
+			return taxicab_heuristic<Dim>();
+		else
+			return [&solver](auto const& n) { return solver.heuristic(n); };
+	}
 }
 
-template <size_t Dim>
+template <size_t Dim, typename Policy = astar::default_search_policy, bool Incremental = false>
 class NSqPuzzleSolverAStar : public NSqPuzzleSolver<Dim>
 {
 public:
@@ -94,10 +107,10 @@ public:
 		std::vector<n_sq_puzzle<Dim>>& path,
 		std::optional<int> max_cost = std::nullopt) const override
 	{
-		return astar::a_star_search(
+		return astar::a_star_search<Policy>(
 			puzzle,
 			[this](auto const& n) { return this->expand(n); },
-			[this](auto const& n) { return this->heuristic(n); },
+			solver_heuristic<Incremental>(*this),
 			[this](auto const& n, auto const& m) { return this->dist(n, m); },
 			[this](auto const& n) { return this->is_goal(n); },
 			std::back_inserter(path),
@@ -106,7 +119,7 @@ public:
 	}
 };
 
-template <size_t Dim>
+template <size_t Dim, typename Policy = astar::default_ida_search_policy, bool Incremental = false>
 class NSqPuzzleSolverIDAStar : public NSqPuzzleSolver<Dim>
 {
 public:
@@ -117,10 +130,10 @@ public:
 		std::vector<n_sq_puzzle<Dim>>& path,
 		std::optional<int> max_cost = std::nullopt) const override
 	{
-		return astar::ida_star_search(
+		return astar::ida_star_search<Policy>(
 			puzzle,
 			[this](auto const& n) { return this->expand(n); },
-			[this](auto const& n) { return this->heuristic(n); },
+			solver_heuristic<Incremental>(*this),
 			[this](auto const& n, auto const& m) { return this->dist(n, m); },
 			[this](auto const& n) { return this->is_goal(n); },
 			std::back_inserter(path),
@@ -141,7 +154,30 @@ protected:
 using NSqPuzzleSolverTestImplementations = 
 	testing::Types<
 		NSqPuzzleSolverAStar<3>, NSqPuzzleSolverAStar<4>,
-		NSqPuzzleSolverIDAStar<3>, NSqPuzzleSolverIDAStar<4> >;
+		NSqPuzzleSolverAStar<3, astar::search_policy<astar::binary_heap_fringe>>,
+		NSqPuzzleSolverAStar<4, astar::search_policy<astar::d_ary_heap_fringe<4>>>,
+		NSqPuzzleSolverAStar<4, astar::search_policy<astar::bucket_fringe<>>>,
+		NSqPuzzleSolverAStar<4,
+			astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER, astar::arena_node_storage>>,
+		NSqPuzzleSolverAStar<4,
+			astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER, astar::flat_node_storage>>,
+		NSqPuzzleSolverAStar<3, astar::search_policy<astar::bucket_fringe<>, astar::ReopenPolicy::NEVER,
+			astar::dense_node_storage<n_sq_puzzle_index<3>>>>,
+		NSqPuzzleSolverAStar<3, astar::search_policy<astar::binary_heap_fringe, astar::ReopenPolicy::ON_BETTER_COST,
+			astar::dense_node_storage<n_sq_puzzle_index<3>>>>,
+		NSqPuzzleSolverIDAStar<3>, NSqPuzzleSolverIDAStar<4>,
+		NSqPuzzleSolverIDAStar<3, astar::ida_search_policy<astar::flat_node_storage>>,
+		NSqPuzzleSolverIDAStar<3, astar::ida_search_policy<astar::dense_node_storage<n_sq_puzzle_index<3>>>>,
+		NSqPuzzleSolverIDAStar<4, astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT>>,
+		NSqPuzzleSolverIDAStar<3, astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::NONE>>,
+		NSqPuzzleSolverIDAStar<3,
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<>>>,
+		NSqPuzzleSolverIDAStar<4,
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>>,
+		NSqPuzzleSolverAStar<4, astar::search_policy<astar::bucket_fringe<>>, true>,
+		NSqPuzzleSolverIDAStar<4, astar::default_ida_search_policy, true>,
+		NSqPuzzleSolverIDAStar<4,
+			astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>, true> >;
 
 TYPED_TEST_SUITE(NSqPuzzleSolverTest, NSqPuzzleSolverTestImplementations);
 
@@ -188,4 +224,68 @@ TYPED_TEST(NSqPuzzleSolverTest, ExceedsMaxCost)
 	
 	std::vector<n_sq_puzzle<dim>> path;
 	EXPECT_FALSE(this->theTest.solve(puzzle, path, max_cost));
-}
\ No newline at end of file
+}
+template <typename T>
+class IDAStarTranspositionTableTest : public testing::Test { };
+
+using IDAStarTranspositionTableTestImplementations =
+	testing::Types<
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<>>,
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<>>,
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::NONE, astar::bounded_transposition_table<>>,
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PATH, astar::bounded_transposition_table<1 << 20>>,
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<1 << 20>>,
+		astar::ida_search_policy<astar::std_node_storage, astar::CycleCheck::PARENT, astar::bounded_transposition_table<4096>> >;
+
+TYPED_TEST_SUITE(IDAStarTranspositionTableTest, IDAStarTranspositionTableTestImplementations);
+
+TYPED_TEST(IDAStarTranspositionTableTest, SameCostAsAStar)
+{
+	NSqPuzzleSolverAStar<3> const a_star;
+	NSqPuzzleSolverIDAStar<3, TypeParam> const ida_star;
+
+	for (size_t i = 0 ; i < 300 ; i++)
+	{
+		auto const puzzle = n_sq_puzzle<3>::unrank((i * 7919 * 13 + 12345) % 181440);
+
+		std::vector<n_sq_puzzle<3>> expected_path, path;
+		ASSERT_TRUE(a_star.solve(puzzle, expected_path));
+		ASSERT_TRUE(ida_star.solve(puzzle, path)) << puzzle;
+
+		EXPECT_EQ(path.size(), expected_path.size()) << puzzle;
+	}
+}
+
+template <typename T>
+class TaxicabHeuristicTest : public testing::Test { };
+
+using TaxicabHeuristicTestImplementations = testing::Types<n_sq_puzzle<3>, n_sq_puzzle<4>, n_sq_puzzle<5>>;
+
+TYPED_TEST_SUITE(TaxicabHeuristicTest, TaxicabHeuristicTestImplementations);
+
+TYPED_TEST(TaxicabHeuristicTest, IncrementalMatchesFull)
+{
+	using MoveType = typename TypeParam::MoveType;
+	constexpr size_t dim = TypeParam::size();
+
+	TypeParam const goal;
+	taxicab_heuristic<dim> const h;
+
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<int> random_move(0, 3);
+
+	TypeParam puz;
+	size_t dist = h(puz);
+	EXPECT_EQ(dist, 0);
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		TypeParam const parent = puz;
+		if (!puz.move(static_cast<MoveType>(random_move(gen))))
+			continue;
+
+		dist = h(parent, dist, puz);
+		ASSERT_EQ(dist, h(puz));
+		ASSERT_EQ(dist, tile_taxicab_dist(puz, goal));
+	}
+}